@@ -0,0 +1,80 @@
+/*
+ * @note: the csim testbench of Convolution2D_DataStream, the AXI layer is checked against the array Convolution2D
+ * 	over several filter, subsample and input shapes, the outputs have to be the same bit for bit
+ * 	the HLS loops of CONVOLUTION2D_OPT_MODE are run, OPT_STREAM unless it is given, e.g. in example/hls/testbench
+ * 		g++ -I<Vivado HLS>/include convolution2D_stream_tb.cpp -o tb && ./tb
+ * 		g++ -I<Vivado HLS>/include -DCONVOLUTION2D_OPT_MODE=OPT_BUFFER convolution2D_stream_tb.cpp -o tb && ./tb
+ */
+#ifndef CONVOLUTION2D_OPT_MODE
+#define CONVOLUTION2D_OPT_MODE		OPT_STREAM
+#endif
+#define HOST_BACKEND				0
+#include "../../../source/SDAI/sdai.h"
+#include <iostream>
+#include <stdlib.h>
+using namespace std;
+using namespace SDAI;
+
+/*
+ * @note: the weight, bias and input of the tests, large enough for every shape
+ */
+TYPE_T	weight[8192];
+TYPE_T	bias[64];
+TYPE_T	sample[8192];
+TYPE_T	res[8192];
+
+/*
+ * @note: compare the two layers of one shape, the number of different outputs is returned
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM, int SUBSAMPLE_ROW, int SUBSAMPLE_COL>
+int test()
+{
+	const int OUT_ROW = (ROW - NB_ROW)/SUBSAMPLE_ROW + 1;
+	const int OUT_COL = (COL - NB_COL)/SUBSAMPLE_COL + 1;
+
+	Convolution2D<NB_FILTER, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, RELU, SUBSAMPLE_ROW, SUBSAMPLE_COL>				conv(weight, bias);
+	Convolution2D_DataStream<NB_FILTER, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, RELU, SUBSAMPLE_ROW, SUBSAMPLE_COL>	stream(weight, bias);
+
+	conv.feedforward((TYPE_T (*)[COL][INPUT_DIM])sample);
+	stream.feedforward(sample, res);
+
+	int n_wrong = 0;
+	for( int i = 0; i < OUT_ROW * OUT_COL * NB_FILTER; i++)
+	{
+		if( res[i] != (&conv.res[0][0][0])[i] )
+			n_wrong++;
+	}
+	cout << "NB_ROW = " << NB_ROW << ", NB_COL = " << NB_COL << ", SUBSAMPLE = " << SUBSAMPLE_ROW << "x" << SUBSAMPLE_COL
+		<< ", INPUT_DIM = " << INPUT_DIM << ": " << n_wrong << " wrong in " << OUT_ROW * OUT_COL * NB_FILTER << endl;
+	return n_wrong;
+}
+
+int main()
+{
+	srand(1);
+	for( int i = 0; i < 8192; i++)
+	{
+		weight[i] = (rand() % 2001 - 1000) / 1000.0;
+		sample[i] = (rand() % 2001 - 1000) / 1000.0;
+	}
+	for( int i = 0; i < 64; i++)
+		bias[i] = (rand() % 2001 - 1000) / 1000.0;
+
+	int n_wrong = 0;
+	n_wrong += test<3, 3, 3, 28, 28, 1, 1, 1>();
+	n_wrong += test<6, 3, 3, 13, 13, 3, 1, 1>();
+	n_wrong += test<4, 5, 5, 16, 12, 2, 1, 1>();
+	n_wrong += test<4, 3, 3, 15, 15, 2, 2, 2>();
+#if CONVOLUTION2D_OPT_MODE != OPT_BUFFER
+	/* the circular buffers of OPT_BUFFER need SUBSAMPLE_ROW <= NB_ROW and SUBSAMPLE_COL <= NB_COL */
+	n_wrong += test<5, 2, 3, 14, 11, 3, 3, 1>();
+	n_wrong += test<2, 4, 2, 17, 10, 1, 2, 3>();
+	n_wrong += test<3, 1, 1, 9, 9, 4, 1, 2>();
+#endif
+
+	if( n_wrong )
+		cout << "FAILED" << endl;
+	else
+		cout << "PASSED" << endl;
+	return n_wrong ? 1 : 0;
+}
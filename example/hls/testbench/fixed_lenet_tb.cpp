@@ -0,0 +1,143 @@
+/*
+ * @note: the csim testbench of the fixed point emulation, the network of the LeNet_v2 example is run with ap_fixed
+ * 	and with Fixed of fixed.h in the same formats, the outputs of every layer have to be the same bit for bit
+ * 	FIXED_EMULATION in configure.h can be set to 1 once it passes with the ap_fixed of the Vivado HLS in use
+ * 	it is built with the sources of example/hls/LeNet_v2.zip and run from their directory, e.g. in LeNet_v2/src
+ * 		g++ -I<Vivado HLS>/include -I. <SDAI>/example/hls/testbench/fixed_lenet_tb.cpp -o tb && ./tb
+ * 	or with the open-source HLS_arbitrary_Precision_Types headers, which have no hls_stream.h
+ * 		g++ -I<HLS_arbitrary_Precision_Types>/include -DHLS_STREAM=0 -I. <SDAI>/example/hls/testbench/fixed_lenet_tb.cpp -o tb && ./tb
+ */
+#include "../../../source/SDAI/sdai.h"
+#include "top.h"
+#include <iostream>
+#include <stdio.h>
+using namespace std;
+
+/*
+ * @note: the network of Neural() in LeNet_v2/src/top.cpp, DATA_T is the type of the data, WEIGHT_T of the weight
+ * 	and ACC_T of the sums of products
+ */
+template<typename DATA_T, typename WEIGHT_T, typename ACC_T>
+class LeNet
+{
+public:
+	LeNet()
+		:conv1(weight1, bias1), conv2(weight2, bias2), dense(weight3), dense2(weight4)
+	{
+	}
+
+public:
+	Convolution2D<NB_FILTER1, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, RELU, SUBSAMPLE_ROW, SUBSAMPLE_COL,
+		POOLING1_ROW, POOLING1_COL, DATA_T, WEIGHT_T, ACC_T>											conv1;
+	MaxPooling2D<POOLING1_ROW, POOLING1_COL, NB_FILTER1, POOLING_ROW, POOLING_COL, ROW2, COL2, DATA_T>		pool1;
+	Convolution2D<NB_FILTER2, NB_ROW, NB_COL, ROW2, COL2, INPUT_DIM2, RELU, SUBSAMPLE_ROW, SUBSAMPLE_COL,
+		POOLING2_ROW, POOLING2_COL, DATA_T, WEIGHT_T, ACC_T>											conv2;
+	MaxPooling2D<POOLING2_ROW, POOLING2_COL, NB_FILTER2, POOLING_ROW, POOLING_COL,
+		POOLING2_ROW/POOLING_ROW, POOLING2_COL/POOLING_COL, DATA_T>										pool2;
+	Reshape3D_1D<POOLING2_ROW/POOLING_ROW, POOLING2_COL/POOLING_COL, NB_FILTER2, ORDER_X, DENSE_INPUT, DATA_T>	reshape;
+	Dense<DENSE_INPUT, DENSE_OUTPUT, RELU, DATA_T, WEIGHT_T, ACC_T>										dense;
+	Dense<DENSE_OUTPUT, DENSE2_OUTPUT, SOFTMAX, DATA_T, WEIGHT_T, ACC_T>								dense2;
+
+public:
+	void feedforward(const float *sample)
+	{
+		DATA_T data[ROW][COL][INPUT_DIM];
+		for( int i = 0; i < ROW; i++)
+			for( int j = 0; j < COL; j++)
+				for( int v = 0; v < INPUT_DIM; v++)
+					data[i][j][v] = sample[i * COL * INPUT_DIM + j * INPUT_DIM + v];
+
+		conv1.feedforward(data);
+		pool1.feedforward(conv1.res);
+		conv2.feedforward(pool1.res);
+		pool2.feedforward(conv2.res);
+		reshape.feedforward(pool2.res);
+		dense.feedforward(reshape.res);
+		dense2.feedforward(dense.res);
+	}
+};
+
+/*
+ * @note: the number of different values of two layer outputs, both types are exact in double
+ */
+template<typename A, typename B>
+int compare(const A *a, const B *b, int N)
+{
+	int n_wrong = 0;
+	for( int i = 0; i < N; i++)
+	{
+		if( (double)a[i] != (double)b[i] )
+			n_wrong++;
+	}
+	return n_wrong;
+}
+
+const int N = 480;
+float			sample[N * ROW * COL];
+unsigned int	std_result[N];
+
+/*
+ * @note: run the N samples with DATA_T and WEIGHT_T in <W, I, Q, O> and ACC_T in <ACC_W, ACC_I, Q, O>,
+ * 	the number of different outputs is returned
+ */
+template<int W, int I, ap_q_mode Q, ap_o_mode O, int ACC_W, int ACC_I>
+int test()
+{
+	static LeNet<ap_fixed<W, I, Q, O>, ap_fixed<W, I, Q, O>, ap_fixed<ACC_W, ACC_I, Q, O> >	ap;
+	static LeNet<Fixed<W, I, Q, O>, Fixed<W, I, Q, O>, Fixed<ACC_W, ACC_I, Q, O> >				emu;
+
+	int n_wrong = 0, n_class = 0;
+	for( int k = 0; k < N; k++)
+	{
+		ap.feedforward(&sample[k * ROW * COL]);
+		emu.feedforward(&sample[k * ROW * COL]);
+
+		n_wrong += compare(&ap.conv1.res[0][0][0], &emu.conv1.res[0][0][0], POOLING1_ROW * POOLING1_COL * NB_FILTER1);
+		n_wrong += compare(&ap.pool1.res[0][0][0], &emu.pool1.res[0][0][0], ROW2 * COL2 * NB_FILTER1);
+		n_wrong += compare(&ap.conv2.res[0][0][0], &emu.conv2.res[0][0][0], POOLING2_ROW * POOLING2_COL * NB_FILTER2);
+		n_wrong += compare(ap.reshape.res, emu.reshape.res, DENSE_INPUT);
+		n_wrong += compare(ap.dense.res, emu.dense.res, DENSE_OUTPUT);
+		n_wrong += compare(ap.dense2.res, emu.dense2.res, DENSE2_OUTPUT);
+
+		if( utils_find_category<DENSE2_OUTPUT>(ap.dense2.res) == std_result[k] )
+			n_class++;
+	}
+	cout << "ap_fixed<" << W << ", " << I << ", " << Q << ", " << O << ">, ACC " << ACC_W << "." << ACC_I << ": "
+		<< n_wrong << " different outputs, accuracy of ap_fixed " << float(n_class) / N << endl;
+	return n_wrong;
+}
+
+int main()
+{
+	FILE *fp = fopen("result.txt", "r");
+	if( !fp )
+	{
+		cout << " Failed to open result.txt " << endl;
+		return 1;
+	}
+	for( int i = 0; i < N; i++)
+		fscanf(fp, "%u", &std_result[i]);
+	fclose(fp);
+
+	fp = fopen("validation.txt", "r");
+	if( !fp )
+	{
+		cout << " Failed to open validation.txt " << endl;
+		return 1;
+	}
+	for( int i = 0; i < N * ROW * COL; i++)
+		fscanf(fp, "%f", &sample[i]);
+	fclose(fp);
+
+	int n_wrong = 0;
+	n_wrong += test<20, 12, AP_TRN_ZERO, AP_WRAP, 20, 12>();
+	n_wrong += test<15, 6, AP_TRN_ZERO, AP_WRAP, 24, 10>();
+	n_wrong += test<16, 6, AP_RND, AP_SAT, 32, 12>();
+	n_wrong += test<12, 4, AP_RND_CONV, AP_SAT, 24, 8>();
+
+	if( n_wrong )
+		cout << "FAILED" << endl;
+	else
+		cout << "PASSED" << endl;
+	return n_wrong ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * @note: the csim testbench of the fixed point emulation, the network of the LSTM_v2 example is run with ap_fixed
+ * 	and with Fixed of fixed.h in the same formats, the outputs of every layer have to be the same bit for bit
+ * 	FIXED_EMULATION in configure.h can be set to 1 once it passes with the ap_fixed of the Vivado HLS in use
+ * 	it is built with the sources of example/hls/LSTM_v2.zip and run from their directory, e.g. in LSTM_v2/src
+ * 		g++ -I<Vivado HLS>/include -I. <SDAI>/example/hls/testbench/fixed_lstm_tb.cpp -o tb && ./tb
+ * 	or with the open-source HLS_arbitrary_Precision_Types headers, which have no hls_stream.h
+ * 		g++ -I<HLS_arbitrary_Precision_Types>/include -DHLS_STREAM=0 -I. <SDAI>/example/hls/testbench/fixed_lstm_tb.cpp -o tb && ./tb
+ */
+#include "../../../source/SDAI/sdai.h"
+#include "top.h"
+#include <iostream>
+#include <stdio.h>
+using namespace std;
+
+/*
+ * @note: the network of Neural() in LSTM_v2/src/top.cpp, DATA_T is the type of the data, WEIGHT_T of the weight
+ * 	and ACC_T of the sums of products
+ */
+template<typename DATA_T, typename WEIGHT_T, typename ACC_T>
+class LSTM_Net
+{
+public:
+	LSTM_Net()
+		:lstm_nn(weight_i, weight_c, weight_f, weight_o), dense(dense_weight)
+	{
+	}
+
+public:
+	LSTM<INPUT_LENGTH, INPUT_DIM, OUTPUT_DIM, TANH, SIGMOID, DATA_T, WEIGHT_T, ACC_T>		lstm_nn;
+	Dense<OUTPUT_DIM, NB_CLASS, SOFTMAX, DATA_T, WEIGHT_T, ACC_T>							dense;
+
+public:
+	void feedforward(const float *sample)
+	{
+		DATA_T data[INPUT_LENGTH][INPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+			for( int j = 0; j < INPUT_DIM; j++)
+				data[i][j] = sample[i * INPUT_DIM + j];
+
+		lstm_nn.feedforward(data);
+		dense.feedforward(lstm_nn.res);
+	}
+};
+
+/*
+ * @note: the number of different values of two layer outputs, both types are exact in double
+ */
+template<typename A, typename B>
+int compare(const A *a, const B *b, int N)
+{
+	int n_wrong = 0;
+	for( int i = 0; i < N; i++)
+	{
+		if( (double)a[i] != (double)b[i] )
+			n_wrong++;
+	}
+	return n_wrong;
+}
+
+const int N = 480;
+float			sample[N * IN_SIZE];
+unsigned int	std_result[N];
+
+/*
+ * @note: run the N samples with DATA_T and WEIGHT_T in <W, I, Q, O> and ACC_T in <ACC_W, ACC_I, Q, O>,
+ * 	the number of different outputs is returned
+ */
+template<int W, int I, ap_q_mode Q, ap_o_mode O, int ACC_W, int ACC_I>
+int test()
+{
+	static LSTM_Net<ap_fixed<W, I, Q, O>, ap_fixed<W, I, Q, O>, ap_fixed<ACC_W, ACC_I, Q, O> >	ap;
+	static LSTM_Net<Fixed<W, I, Q, O>, Fixed<W, I, Q, O>, Fixed<ACC_W, ACC_I, Q, O> >			emu;
+
+	int n_wrong = 0, n_class = 0;
+	for( int k = 0; k < N; k++)
+	{
+		ap.feedforward(&sample[k * IN_SIZE]);
+		emu.feedforward(&sample[k * IN_SIZE]);
+
+		n_wrong += compare(ap.lstm_nn.res, emu.lstm_nn.res, OUTPUT_DIM);
+		n_wrong += compare(ap.lstm_nn.ct, emu.lstm_nn.ct, OUTPUT_DIM);
+		n_wrong += compare(ap.dense.res, emu.dense.res, NB_CLASS);
+
+		if( utils_find_category<NB_CLASS>(ap.dense.res) == std_result[k] )
+			n_class++;
+	}
+	cout << "ap_fixed<" << W << ", " << I << ", " << Q << ", " << O << ">, ACC " << ACC_W << "." << ACC_I << ": "
+		<< n_wrong << " different outputs, accuracy of ap_fixed " << float(n_class) / N << endl;
+	return n_wrong;
+}
+
+int main()
+{
+	FILE *fp = fopen("result.txt", "r");
+	if( !fp )
+	{
+		cout << " Failed to open result.txt " << endl;
+		return 1;
+	}
+	for( int i = 0; i < N; i++)
+		fscanf(fp, "%u", &std_result[i]);
+	fclose(fp);
+
+	fp = fopen("validation.txt", "r");
+	if( !fp )
+	{
+		cout << " Failed to open validation.txt " << endl;
+		return 1;
+	}
+	for( int i = 0; i < N * IN_SIZE; i++)
+		fscanf(fp, "%f", &sample[i]);
+	fclose(fp);
+
+	/* the samples are scaled as in LSTM_v2/src/main.cpp */
+	for( int i = 0; i < N * IN_SIZE; i++)
+		sample[i] *= 100;
+
+	int n_wrong = 0;
+	n_wrong += test<20, 12, AP_TRN_ZERO, AP_WRAP, 20, 12>();
+	n_wrong += test<16, 8, AP_RND, AP_SAT, 32, 12>();
+	n_wrong += test<24, 10, AP_RND_CONV, AP_SAT, 32, 12>();
+
+	if( n_wrong )
+		cout << "FAILED" << endl;
+	else
+		cout << "PASSED" << endl;
+	return n_wrong ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * @note: the csim testbench of the power of two weights, the network of the LeNet_v2 example is run with Convolution2D_Pow2
+ * 	and Dense_Pow2 in place of Convolution2D and Dense, and the accuracy is checked against result.txt as in main.cpp
+ * 	POW2_NB_TERM is the number of terms of a weight, 0 runs the float layers of Neural() as the reference,
+ * 	it is built with the sources of example/hls/LeNet_v2.zip and run from their directory, e.g. in LeNet_v2/src
+ * 		g++ -I<Vivado HLS>/include -I. -DPOW2_NB_TERM=2 <SDAI>/example/hls/testbench/pow2_lenet_tb.cpp -o tb && ./tb
+ */
+#include "../../../source/SDAI/sdai.h"
+#include "top.h"
+#include <iostream>
+#include <stdio.h>
+using namespace std;
+
+#ifndef POW2_NB_TERM
+#define POW2_NB_TERM		1
+#endif
+
+/*
+ * @note: the network of Neural() in LeNet_v2/src/top.cpp
+ */
+class LeNet
+{
+public:
+	LeNet()
+		:conv1(weight1, bias1), conv2(weight2, bias2), dense(weight3), dense2(weight4)
+	{
+	}
+
+public:
+#if POW2_NB_TERM
+	Convolution2D_Pow2<NB_FILTER1, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, RELU, POW2_NB_TERM, SUBSAMPLE_ROW, SUBSAMPLE_COL,
+		POOLING1_ROW, POOLING1_COL>															conv1;
+	Convolution2D_Pow2<NB_FILTER2, NB_ROW, NB_COL, ROW2, COL2, INPUT_DIM2, RELU, POW2_NB_TERM, SUBSAMPLE_ROW, SUBSAMPLE_COL,
+		POOLING2_ROW, POOLING2_COL>															conv2;
+	Dense_Pow2<DENSE_INPUT, DENSE_OUTPUT, RELU, POW2_NB_TERM>								dense;
+	Dense_Pow2<DENSE_OUTPUT, DENSE2_OUTPUT, SOFTMAX, POW2_NB_TERM>							dense2;
+#else
+	Convolution2D<NB_FILTER1, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, RELU, SUBSAMPLE_ROW, SUBSAMPLE_COL,
+		POOLING1_ROW, POOLING1_COL>															conv1;
+	Convolution2D<NB_FILTER2, NB_ROW, NB_COL, ROW2, COL2, INPUT_DIM2, RELU, SUBSAMPLE_ROW, SUBSAMPLE_COL,
+		POOLING2_ROW, POOLING2_COL>															conv2;
+	Dense<DENSE_INPUT, DENSE_OUTPUT, RELU>													dense;
+	Dense<DENSE_OUTPUT, DENSE2_OUTPUT, SOFTMAX>												dense2;
+#endif
+	MaxPooling2D<POOLING1_ROW, POOLING1_COL, NB_FILTER1, POOLING_ROW, POOLING_COL, ROW2, COL2>	pool1;
+	MaxPooling2D<POOLING2_ROW, POOLING2_COL, NB_FILTER2, POOLING_ROW, POOLING_COL,
+		POOLING2_ROW/POOLING_ROW, POOLING2_COL/POOLING_COL>										pool2;
+	Reshape3D_1D<POOLING2_ROW/POOLING_ROW, POOLING2_COL/POOLING_COL, NB_FILTER2, ORDER_X, DENSE_INPUT>	reshape;
+
+public:
+	unsigned int feedforward(const float *sample)
+	{
+		conv1.feedforward((TYPE_T (*)[COL][INPUT_DIM])sample);
+		pool1.feedforward(conv1.res);
+		conv2.feedforward(pool1.res);
+		pool2.feedforward(conv2.res);
+		reshape.feedforward(pool2.res);
+		dense.feedforward(reshape.res);
+		dense2.feedforward(dense.res);
+		return utils_find_category<DENSE2_OUTPUT>(dense2.res);
+	}
+};
+
+const int N = 480;
+float			sample[N * ROW * COL];
+unsigned int	std_result[N];
+
+int main()
+{
+	FILE *fp = fopen("result.txt", "r");
+	if( !fp )
+	{
+		cout << " Failed to open result.txt " << endl;
+		return 1;
+	}
+	for( int i = 0; i < N; i++)
+		fscanf(fp, "%u", &std_result[i]);
+	fclose(fp);
+
+	fp = fopen("validation.txt", "r");
+	if( !fp )
+	{
+		cout << " Failed to open validation.txt " << endl;
+		return 1;
+	}
+	for( int i = 0; i < N * ROW * COL; i++)
+		fscanf(fp, "%f", &sample[i]);
+	fclose(fp);
+
+#if POW2_NB_TERM
+	/* the error of the power of two weights of each layer */
+	float max_err, mean_err;
+	pow2_error<POW2_NB_TERM>(weight1, NB_ROW * NB_COL * INPUT_DIM * NB_FILTER1, max_err, mean_err);
+	cout << "conv1: max error " << max_err << ", mean error " << mean_err << endl;
+	pow2_error<POW2_NB_TERM>(weight2, NB_ROW * NB_COL * INPUT_DIM2 * NB_FILTER2, max_err, mean_err);
+	cout << "conv2: max error " << max_err << ", mean error " << mean_err << endl;
+	pow2_error<POW2_NB_TERM>(weight3, DENSE_INPUT * DENSE_OUTPUT, max_err, mean_err);
+	cout << "dense: max error " << max_err << ", mean error " << mean_err << endl;
+	pow2_error<POW2_NB_TERM>(weight4, DENSE_OUTPUT * DENSE2_OUTPUT, max_err, mean_err);
+	cout << "dense2: max error " << max_err << ", mean error " << mean_err << endl;
+#endif
+
+	static LeNet net;
+	int n_wrong = 0;
+	for( int k = 0; k < N; k++)
+	{
+		if( net.feedforward(&sample[k * ROW * COL]) != std_result[k] )
+			n_wrong++;
+	}
+	float rate = float(N - n_wrong) / float(N);
+	cout << "POW2_NB_TERM = " << POW2_NB_TERM << ": " << n_wrong << " wrong in " << N << " samples with accuracy of " << rate << endl;
+	return 0;
+}
@@ -6,12 +6,52 @@
 #define __ACTIVATION_H__
 #include <math.h>
 #include <assert.h>
+#include <stdio.h>
 #include "configure.h"
 
+/*
+ * @note: the vector kernels are only used in C simulation
+ */
+#if ACTIVATION_SIMD && !defined(__SYNTHESIS__)
+#define ACTIVATION_HOST_SIMD	1
+#include "activation_simd.h"
+#else
+#define ACTIVATION_HOST_SIMD	0
+#endif
+
+/*
+ * @note: the constant lookup tables of SIGMOID_LUT, TANH_LUT and SOFTPLUS_LUT
+ */
+#ifndef ACTIVATION_LUT_GENERATE
+#include "activation_lut.h"
+#endif
+
+#if DEBUG
+#include <iostream>
+using namespace std;
+#endif
+
 namespace SDAI
 {
 
-typedef enum{LINEAR, SIGMOID, HARDSIGMOID, TANH, RELU, LEAKYRELU, THRESHOLDEDRELU, SOFTSIGN, SOFTPLUS, SOFTMAX}ACTIVATION;
+typedef enum{LINEAR, SIGMOID, HARDSIGMOID, TANH, RELU, LEAKYRELU, THRESHOLDEDRELU, SOFTSIGN, SOFTPLUS, SOFTMAX,
+	SIGMOID_LUT, TANH_LUT, SOFTPLUS_LUT}ACTIVATION;
+
+/*
+ * @note: activation_fn<AC_FN, T> calculates AC_FN in the type T, which is given explicitly,
+ * 	activation_fn<AC_FN> calculates it in TYPE_T
+ */
+template<typename T>
+struct Activation_Type
+{
+	typedef T type;
+};
+
+template<ACTIVATION AC_FN, typename T>
+inline T activation_fn(typename Activation_Type<T>::type x);
+
+template<ACTIVATION AC_FN>
+inline TYPE_T activation_fn(TYPE_T x);
 
 #define ABS(x)	((x) > 0 ? (x) : -(x))
 
@@ -19,7 +59,8 @@ typedef enum{LINEAR, SIGMOID, HARDSIGMOID, TANH, RELU, LEAKYRELU, THRESHOLDEDREL
 /*
  * @note: the activation function of LINEAR
  */
-inline TYPE_T activation_linear(TYPE_T x)
+template<typename T>
+inline T activation_linear(T x)
 {
 #pragma HLS INLINE
 	return x;
@@ -29,22 +70,24 @@ inline TYPE_T activation_linear(TYPE_T x)
 /*
  * @note: the activation function of SIGMOID
  */
-inline TYPE_T activation_sigmoid(TYPE_T x)
+template<typename T>
+inline T activation_sigmoid(T x)
 {
 #pragma HLS INLINE
-	const TYPE_T c = -1.0;
+	const T c = -1.0;
 	return 1.0/(1.0 + expf(c * x));
 }
 
 /*
  * @note: the activation function of HARD SIGMOID
  */
-inline TYPE_T activation_hardsigmoid(TYPE_T x)
+template<typename T>
+inline T activation_hardsigmoid(T x)
 {
 #pragma HLS INLINE
-	const TYPE_T m = 0.2;
-	const TYPE_T n = 0.5;
-	TYPE_T	v = x * m + n;
+	const T m = 0.2;
+	const T n = 0.5;
+	T	v = x * m + n;
 
 	if( v >= 1.0)
 		return 1.0;
@@ -57,10 +100,11 @@ inline TYPE_T activation_hardsigmoid(TYPE_T x)
 /*
  * @note: the activation function of RELU
  */
-inline TYPE_T activation_relu(TYPE_T x)
+template<typename T>
+inline T activation_relu(T x)
 {
 #pragma HLS INLINE
-	const TYPE_T t = 0;
+	const T t = 0;
 	return x >= t ? x : t;
 }
 
@@ -68,17 +112,19 @@ inline TYPE_T activation_relu(TYPE_T x)
 /*
  * @note: the activation function of TANH
  */
-inline TYPE_T activation_tanh(TYPE_T x)
+template<typename T>
+inline T activation_tanh(T x)
 {
 #pragma HLS INLINE
-	const TYPE_T c = 2.0;
+	const T c = 2.0;
 	return 1.0 - 2.0/(expf(c * x) + 1.0);
 }
 
 /*
  * @note: the activation function of softsign
  */
-inline TYPE_T activation_softsign(TYPE_T x)
+template<typename T>
+inline T activation_softsign(T x)
 {
 #pragma HLS INLINE
 	if( x > 0)
@@ -90,42 +136,56 @@ inline TYPE_T activation_softsign(TYPE_T x)
 /*
  * @note: the activation function of softplus
  */
-inline TYPE_T activation_softplus(TYPE_T x)
+template<typename T>
+inline T activation_softplus(T x)
 {
 #pragma HLS INLINE
 	return logf( 1 + expf(x));
 }
 
 /*
- * @note: the activation function of softmax
+ * @note: one step of the one pass softmax, x is added to the running maximum and the running sum of exp(x - max),
+ * 	the sum is rescaled when x is a new maximum, so every step takes one exp
  */
-template<int OUTPUT_DIM>
-void activation_softmax(TYPE_T in[OUTPUT_DIM])
+template<typename T>
+inline void activation_softmax_step(T x, T &max, T &sum)
 {
-	/* find the maximum */
-	TYPE_T max = in[0];
-	for(int i = 1; i < OUTPUT_DIM; i++)
+#pragma HLS INLINE
+	T d = x - max;
+	T e = expf(-ABS(d));
+	if( d > 0 )
 	{
-#pragma HLS pipeline
-		if( in[i] > max)
-			max = in[i];
+		sum = sum * e + 1;
+		max = x;
+	}
+	else
+	{
+		sum = sum + e;
 	}
+}
 
-	/* calculate the new value */
-	TYPE_T val[OUTPUT_DIM];
-	TYPE_T sum = 0;
-	for( int i = 0; i < OUTPUT_DIM; i++)
+/*
+ * @note: the activation function of softmax, the maximum and the sum are found in one pass
+ * 	with activation_softmax_step
+ */
+template<int OUTPUT_DIM, typename T>
+void activation_softmax(T in[OUTPUT_DIM])
+{
+	/* the running maximum and the sum of exp(in[i] - max) */
+	T max = in[0];
+	T sum = 1;
+	for( int i = 1; i < OUTPUT_DIM; i++)
 	{
 #pragma HLS pipeline
-		val[i] = expf(in[i] - max);
-		sum += val[i];
+		activation_softmax_step(in[i], max, sum);
 	}
 
 	/* calculate the result */
+	T scale = 1.0/sum;
 	for( int i = 0; i < OUTPUT_DIM; i++)
 	{
 #pragma HLS pipeline
-		in[i] = val[i]/sum;
+		in[i] = expf(in[i] - max) * scale;
 	}
 
 }
@@ -137,9 +197,10 @@ void activation_softmax(TYPE_T in[OUTPUT_DIM])
 /*
  * @note: the LeakyRelU
  */
-inline TYPE_T activation_leakyrelu(TYPE_T x)
+template<typename T>
+inline T activation_leakyrelu(T x)
 {
-	const TYPE_T alpha = 0.3;
+	const T alpha = 0.3;
 	if( x < 0.0)
 		return alpha * x;
 	else
@@ -149,41 +210,306 @@ inline TYPE_T activation_leakyrelu(TYPE_T x)
 /*
  * @note: the Thresholded ReLU
  */
-inline TYPE_T activation_thresholdedrelu(TYPE_T x)
+template<typename T>
+inline T activation_thresholdedrelu(T x)
 {
 #pragma HLS INLINE
-	const TYPE_T theta = 1.0;
-	const TYPE_T v = 0.0;
+	const T theta = 1.0;
+	const T v = 0.0;
 	return x > theta ? x : v;
 }
 
 
+/*
+ * @note: the piecewise activation function of AC_FN read from the lookup table value, slope of TABLE_SIZE segments over [RANGE_MIN, RANGE_MAX],
+ * 	ORDER 0 keeps the value at the middle of each segment, ORDER 1 keeps the value at both ends and the slope
+ * 	the input outside [RANGE_MIN, RANGE_MAX] is saturated, except the upper side of SOFTPLUS which gives x
+ */
+template<ACTIVATION AC_FN, int TABLE_SIZE, int RANGE_MIN, int RANGE_MAX, int ORDER, typename T>
+inline T activation_lut_eval(T x, const T value[TABLE_SIZE + 1], const T slope[TABLE_SIZE + 1])
+{
+#pragma HLS INLINE
+	assert(TABLE_SIZE > 0);
+	assert(RANGE_MAX > RANGE_MIN);
+	assert(ORDER == 0 || ORDER == 1);
+
+	const T lo = RANGE_MIN;
+	const T hi = RANGE_MAX;
+	if( x <= lo )
+		return value[0];
+	if( x >= hi )
+		return AC_FN == SOFTPLUS ? x : value[TABLE_SIZE - 1 + ORDER];
+
+	/* the segment of x and the position inside it */
+	const T scale = (float)TABLE_SIZE / (RANGE_MAX - RANGE_MIN);
+	T pos = (x - lo) * scale;
+	int index = (int)pos;
+	if( index > TABLE_SIZE - 1 )
+		index = TABLE_SIZE - 1;
+
+	if( ORDER == 0 )
+		return value[index];
+	else
+		return value[index] + (pos - index) * slope[index];
+}
+
+/*
+ * @note: the lookup tables of SIGMOID_LUT, TANH_LUT and SOFTPLUS_LUT are the constant arrays of activation_lut.h,
+ * 	so they are synthesized as ROMs without the exp and log cores, activation_lut.h is generated by activation_lut_generate
+ * 	for ACTIVATION_LUT_SIZE, ACTIVATION_LUT_RANGE and ACTIVATION_LUT_ORDER, ACTIVATION_LUT_GENERATE is defined
+ * 	before sdai.h to build the generator when they change
+ */
+#ifndef ACTIVATION_LUT_GENERATE
+#if ACTIVATION_LUT_ROM_SIZE != ACTIVATION_LUT_SIZE || ACTIVATION_LUT_ROM_RANGE != ACTIVATION_LUT_RANGE || ACTIVATION_LUT_ROM_ORDER != ACTIVATION_LUT_ORDER
+#error "activation_lut.h does not match ACTIVATION_LUT_SIZE, ACTIVATION_LUT_RANGE and ACTIVATION_LUT_ORDER, regenerate it with activation_lut_generate"
+#endif
+
+template<ACTIVATION AC_FN, typename T>
+struct Activation_LUT;
+
+template<typename T>
+struct Activation_LUT<SIGMOID, T>
+{
+	static const T value[ACTIVATION_LUT_SIZE + 1];
+	static const T slope[ACTIVATION_LUT_SIZE + 1];
+};
+
+template<typename T>
+const T Activation_LUT<SIGMOID, T>::value[ACTIVATION_LUT_SIZE + 1] = ACTIVATION_LUT_SIGMOID_VALUE;
+template<typename T>
+const T Activation_LUT<SIGMOID, T>::slope[ACTIVATION_LUT_SIZE + 1] = ACTIVATION_LUT_SIGMOID_SLOPE;
+
+template<typename T>
+struct Activation_LUT<TANH, T>
+{
+	static const T value[ACTIVATION_LUT_SIZE + 1];
+	static const T slope[ACTIVATION_LUT_SIZE + 1];
+};
+
+template<typename T>
+const T Activation_LUT<TANH, T>::value[ACTIVATION_LUT_SIZE + 1] = ACTIVATION_LUT_TANH_VALUE;
+template<typename T>
+const T Activation_LUT<TANH, T>::slope[ACTIVATION_LUT_SIZE + 1] = ACTIVATION_LUT_TANH_SLOPE;
+
+template<typename T>
+struct Activation_LUT<SOFTPLUS, T>
+{
+	static const T value[ACTIVATION_LUT_SIZE + 1];
+	static const T slope[ACTIVATION_LUT_SIZE + 1];
+};
+
+template<typename T>
+const T Activation_LUT<SOFTPLUS, T>::value[ACTIVATION_LUT_SIZE + 1] = ACTIVATION_LUT_SOFTPLUS_VALUE;
+template<typename T>
+const T Activation_LUT<SOFTPLUS, T>::slope[ACTIVATION_LUT_SIZE + 1] = ACTIVATION_LUT_SOFTPLUS_SLOPE;
+#endif
+
+#ifndef __SYNTHESIS__
+/*
+ * @note: fill the lookup table of AC_FN, TABLE_SIZE segments over [RANGE_MIN, RANGE_MAX], see activation_lut_eval,
+ * 	it is only used on the host to generate activation_lut.h and to evaluate other table parameters
+ */
+template<ACTIVATION AC_FN, int TABLE_SIZE, int RANGE_MIN, int RANGE_MAX, int ORDER, typename T>
+void activation_lut_init(T value[TABLE_SIZE + 1], T slope[TABLE_SIZE + 1])
+{
+	const float step = (float)(RANGE_MAX - RANGE_MIN) / TABLE_SIZE;
+	const float offset = ORDER == 0 ? 0.5 : 0.0;
+	for( int i = 0; i < TABLE_SIZE + 1; i++)
+	{
+		value[i] = activation_fn<AC_FN, T>(RANGE_MIN + (i + offset) * step);
+	}
+	for( int i = 0; i < TABLE_SIZE; i++)
+	{
+		slope[i] = value[i + 1] - value[i];
+	}
+	slope[TABLE_SIZE] = 0;
+}
+
+/*
+ * @note: the piecewise activation function of AC_FN with any table parameters, the table is filled on the first call
+ */
+template<ACTIVATION AC_FN, int TABLE_SIZE, int RANGE_MIN, int RANGE_MAX, int ORDER, typename T>
+inline T activation_lut(T x)
+{
+	static T	value[TABLE_SIZE + 1];
+	static T	slope[TABLE_SIZE + 1];
+	static bool		init = false;
+	if( !init )
+	{
+		activation_lut_init<AC_FN, TABLE_SIZE, RANGE_MIN, RANGE_MAX, ORDER>(value, slope);
+		init = true;
+	}
+	return activation_lut_eval<AC_FN, TABLE_SIZE, RANGE_MIN, RANGE_MAX, ORDER>(x, value, slope);
+}
+
+/*
+ * @note: the error of activation_lut against the exact AC_FN, NB_POINTS inputs are swept over twice the table range
+ * 	to cover the saturated tails, it is used on the host to choose the table parameters
+ */
+template<ACTIVATION AC_FN, int TABLE_SIZE, int RANGE_MIN, int RANGE_MAX, int ORDER>
+void activation_lut_error(int NB_POINTS, float &max_err, float &mean_err)
+{
+	const float lo = 2.0 * RANGE_MIN - RANGE_MAX;
+	const float hi = 2.0 * RANGE_MAX - RANGE_MIN;
+	max_err = 0;
+	mean_err = 0;
+	for( int i = 0; i < NB_POINTS; i++)
+	{
+		float x = lo + (hi - lo) * i / (NB_POINTS - 1);
+		float y = activation_lut<AC_FN, TABLE_SIZE, RANGE_MIN, RANGE_MAX, ORDER>((TYPE_T)x);
+		float err = ABS(y - (float)activation_fn<AC_FN>(x));
+		if( err > max_err )
+			max_err = err;
+		mean_err += err;
+	}
+	mean_err /= NB_POINTS;
+#if DEBUG
+	cout<<"Activation LUT......"<<endl;
+	cout<<"	TABLE_SIZE = " << TABLE_SIZE << endl;
+	cout<<"	RANGE = [" << RANGE_MIN << ", " << RANGE_MAX << "]" << endl;
+	cout<<"	ORDER = " << ORDER << endl;
+	cout<<"	max error = " << max_err << ", mean error = " << mean_err << endl;
+#endif
+}
+
+/*
+ * @note: print one table of activation_lut.h as the macro NAME, 3 values per line as the weights of top.h
+ */
+inline void activation_lut_print(FILE *fp, const char *NAME, const float *table, int N)
+{
+	fprintf(fp, "#define %s \\\n\t{", NAME);
+	for( int i = 0; i < N; i++)
+	{
+		fprintf(fp, "%.8e%s", table[i], i == N - 1 ? "}\n" : (i % 3 == 2 ? ", \\\n\t " : ", "));
+	}
+	fprintf(fp, "\n");
+}
+
+/*
+ * @note: write activation_lut.h for ACTIVATION_LUT_SIZE, ACTIVATION_LUT_RANGE and ACTIVATION_LUT_ORDER,
+ * 	the values are calculated in float as activation_lut_init does
+ */
+inline void activation_lut_generate(FILE *fp)
+{
+	const int N = ACTIVATION_LUT_SIZE + 1;
+	float value[ACTIVATION_LUT_SIZE + 1];
+	float slope[ACTIVATION_LUT_SIZE + 1];
+
+	fprintf(fp, "/*\n * @note: the lookup tables of SIGMOID_LUT, TANH_LUT and SOFTPLUS_LUT, generated by activation_lut_generate in activation.h,\n");
+	fprintf(fp, " * \tdo not edit it by hand\n */\n");
+	fprintf(fp, "#ifndef __ACTIVATION_LUT_H__\n#define __ACTIVATION_LUT_H__\n\n");
+	fprintf(fp, "#define ACTIVATION_LUT_ROM_SIZE\t\t%d\n", ACTIVATION_LUT_SIZE);
+	fprintf(fp, "#define ACTIVATION_LUT_ROM_RANGE\t%d\n", ACTIVATION_LUT_RANGE);
+	fprintf(fp, "#define ACTIVATION_LUT_ROM_ORDER\t%d\n\n", ACTIVATION_LUT_ORDER);
+
+	activation_lut_init<SIGMOID, ACTIVATION_LUT_SIZE, -ACTIVATION_LUT_RANGE, ACTIVATION_LUT_RANGE, ACTIVATION_LUT_ORDER>(value, slope);
+	activation_lut_print(fp, "ACTIVATION_LUT_SIGMOID_VALUE", value, N);
+	activation_lut_print(fp, "ACTIVATION_LUT_SIGMOID_SLOPE", slope, N);
+	activation_lut_init<TANH, ACTIVATION_LUT_SIZE, -ACTIVATION_LUT_RANGE, ACTIVATION_LUT_RANGE, ACTIVATION_LUT_ORDER>(value, slope);
+	activation_lut_print(fp, "ACTIVATION_LUT_TANH_VALUE", value, N);
+	activation_lut_print(fp, "ACTIVATION_LUT_TANH_SLOPE", slope, N);
+	activation_lut_init<SOFTPLUS, ACTIVATION_LUT_SIZE, -ACTIVATION_LUT_RANGE, ACTIVATION_LUT_RANGE, ACTIVATION_LUT_ORDER>(value, slope);
+	activation_lut_print(fp, "ACTIVATION_LUT_SOFTPLUS_VALUE", value, N);
+	activation_lut_print(fp, "ACTIVATION_LUT_SOFTPLUS_SLOPE", slope, N);
+
+	fprintf(fp, "#endif\n");
+}
+#endif
+
+/*
+ * @note: the piecewise activation function of AC_FN read from the ROM of activation_lut.h
+ */
+template<ACTIVATION AC_FN, typename T>
+inline T activation_lut_rom(T x)
+{
+#pragma HLS INLINE
+#ifndef ACTIVATION_LUT_GENERATE
+	return activation_lut_eval<AC_FN, ACTIVATION_LUT_SIZE, -ACTIVATION_LUT_RANGE, ACTIVATION_LUT_RANGE, ACTIVATION_LUT_ORDER>(x,
+			Activation_LUT<AC_FN, T>::value, Activation_LUT<AC_FN, T>::slope);
+#else
+	return activation_lut<AC_FN, ACTIVATION_LUT_SIZE, -ACTIVATION_LUT_RANGE, ACTIVATION_LUT_RANGE, ACTIVATION_LUT_ORDER>(x);
+#endif
+}
+
+
 /*
  * @note: the  activation function
  */
-template<ACTIVATION AC_FN>
-inline TYPE_T activation_fn(TYPE_T x)
+template<ACTIVATION AC_FN, typename T>
+inline T activation_fn(typename Activation_Type<T>::type x)
 {
 #pragma HLS INLINE
-	TYPE_T res;
+	T res;
 	/* calculate the activation function */
 	switch( AC_FN )
 	{
-	case LINEAR: 		res = activation_linear( x ); 		break;
-	case SIGMOID: 		res = activation_sigmoid( x ); 		break;
-	case HARDSIGMOID: 	res = activation_hardsigmoid( x ); 	break;
-	case TANH: 			res = activation_tanh( x ); 		break;
-	case RELU: 			res = activation_relu( x ); 		break;
-	case SOFTSIGN: 		res = activation_softsign( x ); 	break;
-	case SOFTPLUS: 		res = activation_softplus( x ); 	break;
-	case SOFTMAX: 		res = activation_linear( x ); 		break;
-	case LEAKYRELU:		res = activation_leakyrelu( x ); 	break;
-	case THRESHOLDEDRELU:	res = activation_thresholdedrelu( x ); 	break;
+	case LINEAR: 		res = activation_linear<T>( x ); 		break;
+	case SIGMOID: 		res = activation_sigmoid<T>( x ); 		break;
+	case HARDSIGMOID: 	res = activation_hardsigmoid<T>( x ); 	break;
+	case TANH: 			res = activation_tanh<T>( x ); 		break;
+	case RELU: 			res = activation_relu<T>( x ); 		break;
+	case SOFTSIGN: 		res = activation_softsign<T>( x ); 	break;
+	case SOFTPLUS: 		res = activation_softplus<T>( x ); 	break;
+	case SOFTMAX: 		res = activation_linear<T>( x ); 		break;
+	case LEAKYRELU:		res = activation_leakyrelu<T>( x ); 	break;
+	case THRESHOLDEDRELU:	res = activation_thresholdedrelu<T>( x ); 	break;
+	case SIGMOID_LUT:	res = activation_lut_rom<SIGMOID, T>( x ); 	break;
+	case TANH_LUT:		res = activation_lut_rom<TANH, T>( x ); 	break;
+	case SOFTPLUS_LUT:	res = activation_lut_rom<SOFTPLUS, T>( x ); 	break;
 	default: assert( 0 ); break;
 	}
 	return res;
 }
 
+/*
+ * @note: the activation function of TYPE_T
+ */
+template<ACTIVATION AC_FN>
+inline TYPE_T activation_fn(TYPE_T x)
+{
+#pragma HLS INLINE
+	return activation_fn<AC_FN, TYPE_T>(x);
+}
+
+/*
+ * @note: the activation function of a whole array, SOFTMAX is left to activation_softmax as in activation_fn
+ * 	in C simulation the float sigmoid, tanh and softplus are calculated by the vector kernels of activation_simd.h,
+ * 	it is only called by the host backend, the HLS loops call activation_fn on each output
+ */
+#if ACTIVATION_HOST_SIMD
+template<ACTIVATION AC_FN, typename T>
+inline bool activation_apply_simd(T *x, int n)
+{
+	return false;
+}
+
+template<ACTIVATION AC_FN>
+inline bool activation_apply_simd(float *x, int n)
+{
+	switch( AC_FN )
+	{
+	case SIGMOID: 		simd_sigmoid( x, n ); 		return true;
+	case TANH: 			simd_tanh( x, n ); 			return true;
+	case SOFTPLUS: 		simd_softplus( x, n ); 		return true;
+	default: return false;
+	}
+}
+#endif
+
+template<ACTIVATION AC_FN, int N, typename T>
+inline void activation_apply(T x[N])
+{
+#if ACTIVATION_HOST_SIMD
+	if( activation_apply_simd<AC_FN>(x, N) )
+		return;
+#endif
+	for( int i = 0; i < N; i++)
+	{
+#pragma HLS pipeline
+		x[i] = activation_fn<AC_FN, T>(x[i]);
+	}
+}
+
 }
 
 #endif
@@ -0,0 +1,540 @@
+/*
+ * @note: the lookup tables of SIGMOID_LUT, TANH_LUT and SOFTPLUS_LUT, generated by activation_lut_generate in activation.h,
+ * 	do not edit it by hand
+ */
+#ifndef __ACTIVATION_LUT_H__
+#define __ACTIVATION_LUT_H__
+
+#define ACTIVATION_LUT_ROM_SIZE		256
+#define ACTIVATION_LUT_ROM_RANGE	8
+#define ACTIVATION_LUT_ROM_ORDER	1
+
+#define ACTIVATION_LUT_SIGMOID_VALUE \
+	{3.35350138e-04, 3.56970646e-04, 3.79984500e-04, \
+	 4.04481485e-04, 4.30557062e-04, 4.58312890e-04, \
+	 4.87857120e-04, 5.19304886e-04, 5.52778656e-04, \
+	 5.88408846e-04, 6.26334164e-04, 6.66702341e-04, \
+	 7.09670421e-04, 7.55405636e-04, 8.04085925e-04, \
+	 8.55900696e-04, 9.11051175e-04, 9.69751971e-04, \
+	 1.03223103e-03, 1.09873107e-03, 1.16951030e-03, \
+	 1.24484324e-03, 1.32502243e-03, 1.41035847e-03, \
+	 1.50118221e-03, 1.59784558e-03, 1.70072250e-03, \
+	 1.81021111e-03, 1.92673469e-03, 2.05074344e-03, \
+	 2.18271650e-03, 2.32316251e-03, 2.47262302e-03, \
+	 2.63167406e-03, 2.80092703e-03, 2.98103271e-03, \
+	 3.17268260e-03, 3.37661221e-03, 3.59360268e-03, \
+	 3.82448360e-03, 4.07013763e-03, 4.33150213e-03, \
+	 4.60957224e-03, 4.90540592e-03, 5.22012589e-03, \
+	 5.55492472e-03, 5.91106853e-03, 6.28990214e-03, \
+	 6.69285096e-03, 7.12142838e-03, 7.57724140e-03, \
+	 8.06199107e-03, 8.57748557e-03, 9.12563689e-03, \
+	 9.70847718e-03, 1.03281522e-02, 1.09869428e-02, \
+	 1.16872573e-02, 1.24316504e-02, 1.32228220e-02, \
+	 1.40636265e-02, 1.49570862e-02, 1.59063917e-02, \
+	 1.69149134e-02, 1.79862101e-02, 1.91240367e-02, \
+	 2.03323532e-02, 2.16153339e-02, 2.29773689e-02, \
+	 2.44230907e-02, 2.59573571e-02, 2.75852811e-02, \
+	 2.93122306e-02, 3.11438292e-02, 3.30859795e-02, \
+	 3.51448469e-02, 3.73268872e-02, 3.96388397e-02, \
+	 4.20877263e-02, 4.46808673e-02, 4.74258736e-02, \
+	 5.03306314e-02, 5.34033291e-02, 5.66524267e-02, \
+	 6.00866526e-02, 6.37149960e-02, 6.75466955e-02, \
+	 7.15911984e-02, 7.58581758e-02, 8.03574696e-02, \
+	 8.50990489e-02, 9.00929943e-02, 9.53494683e-02, \
+	 1.00878626e-01, 1.06690601e-01, 1.12795405e-01, \
+	 1.19202919e-01, 1.25922769e-01, 1.32964239e-01, \
+	 1.40336260e-01, 1.48047194e-01, 1.56104892e-01, \
+	 1.64516464e-01, 1.73288196e-01, 1.82425529e-01, \
+	 1.91932783e-01, 2.01813221e-01, 2.12068796e-01, \
+	 2.22700149e-01, 2.33706355e-01, 2.45085016e-01, \
+	 2.56832004e-01, 2.68941432e-01, 2.81405628e-01, \
+	 2.94214964e-01, 3.07358027e-01, 3.20821285e-01, \
+	 3.34589452e-01, 3.48645121e-01, 3.62969190e-01, \
+	 3.77540678e-01, 3.92336845e-01, 4.07333404e-01, \
+	 4.22504634e-01, 4.37823504e-01, 4.53261852e-01, \
+	 4.68790621e-01, 4.84380066e-01, 5.00000000e-01, \
+	 5.15619934e-01, 5.31209350e-01, 5.46738148e-01, \
+	 5.62176526e-01, 5.77495396e-01, 5.92666566e-01, \
+	 6.07663155e-01, 6.22459352e-01, 6.37030780e-01, \
+	 6.51354849e-01, 6.65410578e-01, 6.79178715e-01, \
+	 6.92641973e-01, 7.05785036e-01, 7.18594372e-01, \
+	 7.31058598e-01, 7.43167996e-01, 7.54914999e-01, \
+	 7.66293645e-01, 7.77299881e-01, 7.87931204e-01, \
+	 7.98186779e-01, 8.08067203e-01, 8.17574501e-01, \
+	 8.26711774e-01, 8.35483551e-01, 8.43895078e-01, \
+	 8.51952791e-01, 8.59663725e-01, 8.67035747e-01, \
+	 8.74077201e-01, 8.80797088e-01, 8.87204587e-01, \
+	 8.93309414e-01, 8.99121404e-01, 9.04650509e-01, \
+	 9.09906983e-01, 9.14900959e-01, 9.19642508e-01, \
+	 9.24141824e-01, 9.28408802e-01, 9.32453334e-01, \
+	 9.36285019e-01, 9.39913332e-01, 9.43347573e-01, \
+	 9.46596682e-01, 9.49669361e-01, 9.52574134e-01, \
+	 9.55319107e-01, 9.57912266e-01, 9.60361183e-01, \
+	 9.62673128e-01, 9.64855134e-01, 9.66913998e-01, \
+	 9.68856156e-01, 9.70687747e-01, 9.72414732e-01, \
+	 9.74042654e-01, 9.75576937e-01, 9.77022648e-01, \
+	 9.78384674e-01, 9.79667664e-01, 9.80875969e-01, \
+	 9.82013762e-01, 9.83085096e-01, 9.84093606e-01, \
+	 9.85042930e-01, 9.85936344e-01, 9.86777186e-01, \
+	 9.87568378e-01, 9.88312721e-01, 9.89013076e-01, \
+	 9.89671826e-01, 9.90291536e-01, 9.90874350e-01, \
+	 9.91422534e-01, 9.91937995e-01, 9.92422760e-01, \
+	 9.92878556e-01, 9.93307173e-01, 9.93710101e-01, \
+	 9.94088948e-01, 9.94445086e-01, 9.94779885e-01, \
+	 9.95094597e-01, 9.95390415e-01, 9.95668471e-01, \
+	 9.95929837e-01, 9.96175528e-01, 9.96406376e-01, \
+	 9.96623397e-01, 9.96827304e-01, 9.97018993e-01, \
+	 9.97199059e-01, 9.97368336e-01, 9.97527361e-01, \
+	 9.97676849e-01, 9.97817278e-01, 9.97949243e-01, \
+	 9.98073280e-01, 9.98189807e-01, 9.98299301e-01, \
+	 9.98402178e-01, 9.98498797e-01, 9.98589635e-01, \
+	 9.98674989e-01, 9.98755157e-01, 9.98830497e-01, \
+	 9.98901248e-01, 9.98967767e-01, 9.99030232e-01, \
+	 9.99088943e-01, 9.99144077e-01, 9.99195933e-01, \
+	 9.99244571e-01, 9.99290347e-01, 9.99333322e-01, \
+	 9.99373674e-01, 9.99411583e-01, 9.99447227e-01, \
+	 9.99480724e-01, 9.99512136e-01, 9.99541700e-01, \
+	 9.99569416e-01, 9.99595523e-01, 9.99620020e-01, \
+	 9.99643028e-01, 9.99664664e-01}
+
+#define ACTIVATION_LUT_SIGMOID_SLOPE \
+	{2.16205081e-05, 2.30138539e-05, 2.44969851e-05, \
+	 2.60755769e-05, 2.77558283e-05, 2.95442296e-05, \
+	 3.14477657e-05, 3.34737706e-05, 3.56301898e-05, \
+	 3.79253179e-05, 4.03681770e-05, 4.29680804e-05, \
+	 4.57352144e-05, 4.86802892e-05, 5.18147717e-05, \
+	 5.51504781e-05, 5.87007962e-05, 6.24790555e-05, \
+	 6.65000407e-05, 7.07792351e-05, 7.53329368e-05, \
+	 8.01791903e-05, 8.53360398e-05, 9.08237416e-05, \
+	 9.66633670e-05, 1.02876918e-04, 1.09488610e-04, \
+	 1.16523588e-04, 1.24008744e-04, 1.31973065e-04, \
+	 1.40446005e-04, 1.49460509e-04, 1.59051036e-04, \
+	 1.69252977e-04, 1.80105679e-04, 1.91649888e-04, \
+	 2.03929609e-04, 2.16990476e-04, 2.30880920e-04, \
+	 2.45654024e-04, 2.61364505e-04, 2.78070103e-04, \
+	 2.95833685e-04, 3.14719975e-04, 3.34798824e-04, \
+	 3.56143806e-04, 3.78833618e-04, 4.02948819e-04, \
+	 4.28577419e-04, 4.55813017e-04, 4.84749675e-04, \
+	 5.15494496e-04, 5.48151322e-04, 5.82840294e-04, \
+	 6.19675033e-04, 6.58790581e-04, 7.00314529e-04, \
+	 7.44393095e-04, 7.91171566e-04, 8.40804540e-04, \
+	 8.93459655e-04, 9.49305482e-04, 1.00852177e-03, \
+	 1.07129663e-03, 1.13782659e-03, 1.20831653e-03, \
+	 1.28298067e-03, 1.36203505e-03, 1.44572183e-03, \
+	 1.53426640e-03, 1.62792392e-03, 1.72694959e-03, \
+	 1.83159858e-03, 1.94215029e-03, 2.05886737e-03, \
+	 2.18204036e-03, 2.31195241e-03, 2.44888663e-03, \
+	 2.59314105e-03, 2.74500623e-03, 2.90475786e-03, \
+	 3.07269767e-03, 3.24909762e-03, 3.43422592e-03, \
+	 3.62834334e-03, 3.83169949e-03, 4.04450297e-03, \
+	 4.26697731e-03, 4.49929386e-03, 4.74157929e-03, \
+	 4.99394536e-03, 5.25647402e-03, 5.52915782e-03, \
+	 5.81197441e-03, 6.10480458e-03, 6.40751421e-03, \
+	 6.71985000e-03, 7.04146922e-03, 7.37202168e-03, \
+	 7.71093369e-03, 8.05769861e-03, 8.41157138e-03, \
+	 8.77173245e-03, 9.13733244e-03, 9.50725377e-03, \
+	 9.88043845e-03, 1.02555752e-02, 1.06313527e-02, \
+	 1.10062063e-02, 1.13786608e-02, 1.17469877e-02, \
+	 1.21094286e-02, 1.24641955e-02, 1.28093362e-02, \
+	 1.31430626e-02, 1.34632587e-02, 1.37681663e-02, \
+	 1.40556693e-02, 1.43240690e-02, 1.45714879e-02, \
+	 1.47961676e-02, 1.49965584e-02, 1.51712298e-02, \
+	 1.53188705e-02, 1.54383481e-02, 1.55287683e-02, \
+	 1.55894458e-02, 1.56199336e-02, 1.56199336e-02, \
+	 1.55894160e-02, 1.55287981e-02, 1.54383779e-02, \
+	 1.53188705e-02, 1.51711702e-02, 1.49965882e-02, \
+	 1.47961974e-02, 1.45714283e-02, 1.43240690e-02, \
+	 1.40557289e-02, 1.37681365e-02, 1.34632587e-02, \
+	 1.31430626e-02, 1.28093362e-02, 1.24642253e-02, \
+	 1.21093988e-02, 1.17470026e-02, 1.13786459e-02, \
+	 1.10062361e-02, 1.06313229e-02, 1.02555752e-02, \
+	 9.88042355e-03, 9.50729847e-03, 9.13727283e-03, \
+	 8.77177715e-03, 8.41152668e-03, 8.05771351e-03, \
+	 7.71093369e-03, 7.37202168e-03, 7.04145432e-03, \
+	 6.71988726e-03, 6.40749931e-03, 6.10482693e-03, \
+	 5.81198931e-03, 5.52910566e-03, 5.25647402e-03, \
+	 4.99397516e-03, 4.74154949e-03, 4.49931622e-03, \
+	 4.26697731e-03, 4.04453278e-03, 3.83168459e-03, \
+	 3.62831354e-03, 3.43424082e-03, 3.24910879e-03, \
+	 3.07267904e-03, 2.90477276e-03, 2.74497271e-03, \
+	 2.59315968e-03, 2.44891644e-03, 2.31194496e-03, \
+	 2.18200684e-03, 2.05886364e-03, 1.94215775e-03, \
+	 1.83159113e-03, 1.72698498e-03, 1.62792206e-03, \
+	 1.53428316e-03, 1.44571066e-03, 1.36202574e-03, \
+	 1.28298998e-03, 1.20830536e-03, 1.13779306e-03, \
+	 1.07133389e-03, 1.00851059e-03, 9.49323177e-04, \
+	 8.93414021e-04, 8.40842724e-04, 7.91192055e-04, \
+	 7.44342804e-04, 7.00354576e-04, 6.58750534e-04, \
+	 6.19709492e-04, 5.82814217e-04, 5.48183918e-04, \
+	 5.15460968e-04, 4.84764576e-04, 4.55796719e-04, \
+	 4.28617001e-04, 4.02927399e-04, 3.78847122e-04, \
+	 3.56137753e-04, 3.34799290e-04, 3.14712524e-04, \
+	 2.95817852e-04, 2.78055668e-04, 2.61366367e-04, \
+	 2.45690346e-04, 2.30848789e-04, 2.17020512e-04, \
+	 2.03907490e-04, 1.91688538e-04, 1.80065632e-04, \
+	 1.69277191e-04, 1.59025192e-04, 1.49488449e-04, \
+	 1.40428543e-04, 1.31964684e-04, 1.24037266e-04, \
+	 1.16527081e-04, 1.09493732e-04, 1.02877617e-04, \
+	 9.66191292e-05, 9.08374786e-05, 8.53538513e-05, \
+	 8.01682472e-05, 7.53402710e-05, 7.07507133e-05, \
+	 6.65187836e-05, 6.24656677e-05, 5.87105751e-05, \
+	 5.51342964e-05, 5.18560410e-05, 4.86373901e-05, \
+	 4.57763672e-05, 4.29749489e-05, 4.03523445e-05, \
+	 3.79085541e-05, 3.56435776e-05, 3.34978104e-05, \
+	 3.14116478e-05, 2.95639038e-05, 2.77161598e-05, \
+	 2.61068344e-05, 2.44975090e-05, 2.30073929e-05, \
+	 2.16364861e-05, 0.00000000e+00}
+
+#define ACTIVATION_LUT_TANH_VALUE \
+	{-9.99999762e-01, -9.99999762e-01, -9.99999702e-01, \
+	 -9.99999702e-01, -9.99999642e-01, -9.99999583e-01, \
+	 -9.99999523e-01, -9.99999464e-01, -9.99999404e-01, \
+	 -9.99999285e-01, -9.99999225e-01, -9.99999106e-01, \
+	 -9.99998987e-01, -9.99998868e-01, -9.99998689e-01, \
+	 -9.99998510e-01, -9.99998331e-01, -9.99998093e-01, \
+	 -9.99997854e-01, -9.99997556e-01, -9.99997258e-01, \
+	 -9.99996901e-01, -9.99996483e-01, -9.99996006e-01, \
+	 -9.99995470e-01, -9.99994874e-01, -9.99994218e-01, \
+	 -9.99993443e-01, -9.99992549e-01, -9.99991536e-01, \
+	 -9.99990404e-01, -9.99989152e-01, -9.99987721e-01, \
+	 -9.99986053e-01, -9.99984205e-01, -9.99982119e-01, \
+	 -9.99979734e-01, -9.99977052e-01, -9.99974012e-01, \
+	 -9.99970496e-01, -9.99966621e-01, -9.99962151e-01, \
+	 -9.99957085e-01, -9.99951422e-01, -9.99944925e-01, \
+	 -9.99937594e-01, -9.99929309e-01, -9.99919891e-01, \
+	 -9.99909222e-01, -9.99897122e-01, -9.99883413e-01, \
+	 -9.99867916e-01, -9.99850333e-01, -9.99830365e-01, \
+	 -9.99807775e-01, -9.99782205e-01, -9.99753237e-01, \
+	 -9.99720335e-01, -9.99683142e-01, -9.99640942e-01, \
+	 -9.99593139e-01, -9.99538958e-01, -9.99477625e-01, \
+	 -9.99408066e-01, -9.99329329e-01, -9.99240041e-01, \
+	 -9.99138892e-01, -9.99024272e-01, -9.98894453e-01, \
+	 -9.98747349e-01, -9.98580635e-01, -9.98391807e-01, \
+	 -9.98177886e-01, -9.97935534e-01, -9.97660995e-01, \
+	 -9.97349977e-01, -9.96997654e-01, -9.96598542e-01, \
+	 -9.96146560e-01, -9.95634556e-01, -9.95054781e-01, \
+	 -9.94398117e-01, -9.93654609e-01, -9.92812812e-01, \
+	 -9.91859734e-01, -9.90780830e-01, -9.89559770e-01, \
+	 -9.88177836e-01, -9.86614287e-01, -9.84845519e-01, \
+	 -9.82845008e-01, -9.80583072e-01, -9.78026092e-01, \
+	 -9.75136697e-01, -9.71872747e-01, -9.68187213e-01, \
+	 -9.64027584e-01, -9.59335268e-01, -9.54045236e-01, \
+	 -9.48085308e-01, -9.41375554e-01, -9.33828056e-01, \
+	 -9.25346255e-01, -9.15824533e-01, -9.05148268e-01, \
+	 -8.93193364e-01, -8.79826725e-01, -8.64906609e-01, \
+	 -8.48283648e-01, -8.29801917e-01, -8.09301078e-01, \
+	 -7.86618829e-01, -7.61594176e-01, -7.34071493e-01, \
+	 -7.03905582e-01, -6.70967042e-01, -6.35148942e-01, \
+	 -5.96373558e-01, -5.54599702e-01, -5.09829998e-01, \
+	 -4.62117136e-01, -4.11570072e-01, -3.58357400e-01, \
+	 -3.02709699e-01, -2.44918659e-01, -1.85333192e-01, \
+	 -1.24352999e-01, -6.24187514e-02, 0.00000000e+00, \
+	 6.24187365e-02, 1.24353006e-01, 1.85333222e-01, \
+	 2.44918644e-01, 3.02709728e-01, 3.58357430e-01, \
+	 4.11570042e-01, 4.62117136e-01, 5.09829998e-01, \
+	 5.54599702e-01, 5.96373558e-01, 6.35148942e-01, \
+	 6.70967102e-01, 7.03905642e-01, 7.34071493e-01, \
+	 7.61594176e-01, 7.86618829e-01, 8.09301078e-01, \
+	 8.29801917e-01, 8.48283648e-01, 8.64906609e-01, \
+	 8.79826725e-01, 8.93193364e-01, 9.05148268e-01, \
+	 9.15824533e-01, 9.25346255e-01, 9.33828056e-01, \
+	 9.41375554e-01, 9.48085308e-01, 9.54045236e-01, \
+	 9.59335268e-01, 9.64027584e-01, 9.68187213e-01, \
+	 9.71872747e-01, 9.75136697e-01, 9.78026092e-01, \
+	 9.80583072e-01, 9.82845008e-01, 9.84845519e-01, \
+	 9.86614287e-01, 9.88177836e-01, 9.89559770e-01, \
+	 9.90780830e-01, 9.91859734e-01, 9.92812812e-01, \
+	 9.93654609e-01, 9.94398117e-01, 9.95054781e-01, \
+	 9.95634556e-01, 9.96146560e-01, 9.96598542e-01, \
+	 9.96997654e-01, 9.97349977e-01, 9.97660995e-01, \
+	 9.97935534e-01, 9.98177886e-01, 9.98391807e-01, \
+	 9.98580635e-01, 9.98747349e-01, 9.98894453e-01, \
+	 9.99024272e-01, 9.99138892e-01, 9.99240041e-01, \
+	 9.99329329e-01, 9.99408066e-01, 9.99477625e-01, \
+	 9.99538958e-01, 9.99593139e-01, 9.99640942e-01, \
+	 9.99683142e-01, 9.99720335e-01, 9.99753237e-01, \
+	 9.99782205e-01, 9.99807775e-01, 9.99830365e-01, \
+	 9.99850333e-01, 9.99867916e-01, 9.99883413e-01, \
+	 9.99897122e-01, 9.99909222e-01, 9.99919891e-01, \
+	 9.99929309e-01, 9.99937594e-01, 9.99944925e-01, \
+	 9.99951422e-01, 9.99957085e-01, 9.99962151e-01, \
+	 9.99966621e-01, 9.99970496e-01, 9.99974012e-01, \
+	 9.99977052e-01, 9.99979734e-01, 9.99982119e-01, \
+	 9.99984205e-01, 9.99986053e-01, 9.99987721e-01, \
+	 9.99989152e-01, 9.99990404e-01, 9.99991536e-01, \
+	 9.99992549e-01, 9.99993443e-01, 9.99994218e-01, \
+	 9.99994874e-01, 9.99995470e-01, 9.99996006e-01, \
+	 9.99996483e-01, 9.99996901e-01, 9.99997258e-01, \
+	 9.99997556e-01, 9.99997854e-01, 9.99998093e-01, \
+	 9.99998331e-01, 9.99998510e-01, 9.99998689e-01, \
+	 9.99998868e-01, 9.99998987e-01, 9.99999106e-01, \
+	 9.99999225e-01, 9.99999285e-01, 9.99999404e-01, \
+	 9.99999464e-01, 9.99999523e-01, 9.99999583e-01, \
+	 9.99999642e-01, 9.99999702e-01, 9.99999702e-01, \
+	 9.99999762e-01, 9.99999762e-01}
+
+#define ACTIVATION_LUT_TANH_SLOPE \
+	{0.00000000e+00, 5.96046448e-08, 0.00000000e+00, \
+	 5.96046448e-08, 5.96046448e-08, 5.96046448e-08, \
+	 5.96046448e-08, 5.96046448e-08, 1.19209290e-07, \
+	 5.96046448e-08, 1.19209290e-07, 1.19209290e-07, \
+	 1.19209290e-07, 1.78813934e-07, 1.78813934e-07, \
+	 1.78813934e-07, 2.38418579e-07, 2.38418579e-07, \
+	 2.98023224e-07, 2.98023224e-07, 3.57627869e-07, \
+	 4.17232513e-07, 4.76837158e-07, 5.36441803e-07, \
+	 5.96046448e-07, 6.55651093e-07, 7.74860382e-07, \
+	 8.94069672e-07, 1.01327896e-06, 1.13248825e-06, \
+	 1.25169754e-06, 1.43051147e-06, 1.66893005e-06, \
+	 1.84774399e-06, 2.08616257e-06, 2.38418579e-06, \
+	 2.68220901e-06, 3.03983688e-06, 3.51667404e-06, \
+	 3.87430191e-06, 4.47034836e-06, 5.06639481e-06, \
+	 5.66244125e-06, 6.49690628e-06, 7.33137131e-06, \
+	 8.28504562e-06, 9.41753387e-06, 1.06692314e-05, \
+	 1.20997429e-05, 1.37090683e-05, 1.54972076e-05, \
+	 1.75833702e-05, 1.99675560e-05, 2.25901604e-05, \
+	 2.55703926e-05, 2.89678574e-05, 3.29017639e-05, \
+	 3.71932983e-05, 4.22000885e-05, 4.78029251e-05, \
+	 5.41806221e-05, 6.13331795e-05, 6.95586205e-05, \
+	 7.87377357e-05, 8.92877579e-05, 1.01149082e-04, \
+	 1.14619732e-04, 1.29818916e-04, 1.47104263e-04, \
+	 1.66714191e-04, 1.88827515e-04, 2.13921070e-04, \
+	 2.42352486e-04, 2.74538994e-04, 3.11017036e-04, \
+	 3.52323055e-04, 3.99112701e-04, 4.51982021e-04, \
+	 5.12003899e-04, 5.79774380e-04, 6.56664371e-04, \
+	 7.43508339e-04, 8.41796398e-04, 9.53078270e-04, \
+	 1.07890368e-03, 1.22106075e-03, 1.38193369e-03, \
+	 1.56354904e-03, 1.76876783e-03, 2.00051069e-03, \
+	 2.26193666e-03, 2.55697966e-03, 2.88939476e-03, \
+	 3.26395035e-03, 3.68553400e-03, 4.15962934e-03, \
+	 4.69231606e-03, 5.29003143e-03, 5.95992804e-03, \
+	 6.70975447e-03, 7.54749775e-03, 8.48180056e-03, \
+	 9.52172279e-03, 1.06762648e-02, 1.19549036e-02, \
+	 1.33666396e-02, 1.49201155e-02, 1.66229606e-02, \
+	 1.84817314e-02, 2.05008388e-02, 2.26822495e-02, \
+	 2.50246525e-02, 2.75226831e-02, 3.01659107e-02, \
+	 3.29385400e-02, 3.58181000e-02, 3.87753844e-02, \
+	 4.17738557e-02, 4.47697043e-02, 4.77128625e-02, \
+	 5.05470634e-02, 5.32126725e-02, 5.56477010e-02, \
+	 5.77910393e-02, 5.95854670e-02, 6.09801933e-02, \
+	 6.19342476e-02, 6.24187514e-02, 6.24187365e-02, \
+	 6.19342700e-02, 6.09802157e-02, 5.95854223e-02, \
+	 5.77910841e-02, 5.56477010e-02, 5.32126129e-02, \
+	 5.05470932e-02, 4.77128625e-02, 4.47697043e-02, \
+	 4.17738557e-02, 3.87753844e-02, 3.58181596e-02, \
+	 3.29385400e-02, 3.01658511e-02, 2.75226831e-02, \
+	 2.50246525e-02, 2.26822495e-02, 2.05008388e-02, \
+	 1.84817314e-02, 1.66229606e-02, 1.49201155e-02, \
+	 1.33666396e-02, 1.19549036e-02, 1.06762648e-02, \
+	 9.52172279e-03, 8.48180056e-03, 7.54749775e-03, \
+	 6.70975447e-03, 5.95992804e-03, 5.29003143e-03, \
+	 4.69231606e-03, 4.15962934e-03, 3.68553400e-03, \
+	 3.26395035e-03, 2.88939476e-03, 2.55697966e-03, \
+	 2.26193666e-03, 2.00051069e-03, 1.76876783e-03, \
+	 1.56354904e-03, 1.38193369e-03, 1.22106075e-03, \
+	 1.07890368e-03, 9.53078270e-04, 8.41796398e-04, \
+	 7.43508339e-04, 6.56664371e-04, 5.79774380e-04, \
+	 5.12003899e-04, 4.51982021e-04, 3.99112701e-04, \
+	 3.52323055e-04, 3.11017036e-04, 2.74538994e-04, \
+	 2.42352486e-04, 2.13921070e-04, 1.88827515e-04, \
+	 1.66714191e-04, 1.47104263e-04, 1.29818916e-04, \
+	 1.14619732e-04, 1.01149082e-04, 8.92877579e-05, \
+	 7.87377357e-05, 6.95586205e-05, 6.13331795e-05, \
+	 5.41806221e-05, 4.78029251e-05, 4.22000885e-05, \
+	 3.71932983e-05, 3.29017639e-05, 2.89678574e-05, \
+	 2.55703926e-05, 2.25901604e-05, 1.99675560e-05, \
+	 1.75833702e-05, 1.54972076e-05, 1.37090683e-05, \
+	 1.20997429e-05, 1.06692314e-05, 9.41753387e-06, \
+	 8.28504562e-06, 7.33137131e-06, 6.49690628e-06, \
+	 5.66244125e-06, 5.06639481e-06, 4.47034836e-06, \
+	 3.87430191e-06, 3.51667404e-06, 3.03983688e-06, \
+	 2.68220901e-06, 2.38418579e-06, 2.08616257e-06, \
+	 1.84774399e-06, 1.66893005e-06, 1.43051147e-06, \
+	 1.25169754e-06, 1.13248825e-06, 1.01327896e-06, \
+	 8.94069672e-07, 7.74860382e-07, 6.55651093e-07, \
+	 5.96046448e-07, 5.36441803e-07, 4.76837158e-07, \
+	 4.17232513e-07, 3.57627869e-07, 2.98023224e-07, \
+	 2.98023224e-07, 2.38418579e-07, 2.38418579e-07, \
+	 1.78813934e-07, 1.78813934e-07, 1.78813934e-07, \
+	 1.19209290e-07, 1.19209290e-07, 1.19209290e-07, \
+	 5.96046448e-08, 1.19209290e-07, 5.96046448e-08, \
+	 5.96046448e-08, 5.96046448e-08, 5.96046448e-08, \
+	 5.96046448e-08, 0.00000000e+00, 5.96046448e-08, \
+	 0.00000000e+00, 0.00000000e+00}
+
+#define ACTIVATION_LUT_SOFTPLUS_VALUE \
+	{3.35398683e-04, 3.57087265e-04, 3.80086189e-04, \
+	 4.04514489e-04, 4.30610438e-04, 4.58373863e-04, \
+	 4.87923768e-04, 5.19498310e-04, 5.52978192e-04, \
+	 5.88601397e-04, 6.26486959e-04, 6.66872773e-04, \
+	 7.09877699e-04, 7.55739689e-04, 8.04458279e-04, \
+	 8.56271246e-04, 9.11416369e-04, 9.70250403e-04, \
+	 1.03277259e-03, 1.09933957e-03, 1.17018865e-03, \
+	 1.24567619e-03, 1.32591999e-03, 1.41139515e-03, \
+	 1.50233845e-03, 1.59910542e-03, 1.70217047e-03, \
+	 1.81188842e-03, 1.92861422e-03, 2.05282122e-03, \
+	 2.18510139e-03, 2.32580816e-03, 2.47565191e-03, \
+	 2.63510342e-03, 2.80487188e-03, 2.98542739e-03, \
+	 3.17771453e-03, 3.38232075e-03, 3.60006979e-03, \
+	 3.83178447e-03, 4.07840498e-03, 4.34086937e-03, \
+	 4.62023355e-03, 4.91743209e-03, 5.23375394e-03, \
+	 5.57036558e-03, 5.92855085e-03, 6.30982593e-03, \
+	 6.71534892e-03, 7.14686560e-03, 7.60611659e-03, \
+	 8.09471961e-03, 8.61452147e-03, 9.16748308e-03, \
+	 9.75590851e-03, 1.03818607e-02, 1.10477433e-02, \
+	 1.17560681e-02, 1.25095714e-02, 1.33109735e-02, \
+	 1.41634494e-02, 1.50700388e-02, 1.60342306e-02, \
+	 1.70596074e-02, 1.81499608e-02, 1.93092879e-02, \
+	 2.05419008e-02, 2.18523089e-02, 2.32454482e-02, \
+	 2.47263163e-02, 2.63002142e-02, 2.79728435e-02, \
+	 2.97504161e-02, 3.16390693e-02, 3.36456560e-02, \
+	 3.57772857e-02, 3.80414128e-02, 4.04458344e-02, \
+	 4.29991111e-02, 4.57097813e-02, 4.85873297e-02, \
+	 5.16413972e-02, 5.48821911e-02, 5.83204739e-02, \
+	 6.19676150e-02, 6.58353642e-02, 6.99362308e-02, \
+	 7.42831230e-02, 7.88897499e-02, 8.37701932e-02, \
+	 8.89394581e-02, 9.44129080e-02, 1.00206584e-01, \
+	 1.06337272e-01, 1.12822242e-01, 1.19679682e-01, \
+	 1.26928046e-01, 1.34586588e-01, 1.42675087e-01, \
+	 1.51213989e-01, 1.60224199e-01, 1.69727027e-01, \
+	 1.79744646e-01, 1.90299168e-01, 2.01413333e-01, \
+	 2.13110030e-01, 2.25412622e-01, 2.38344491e-01, \
+	 2.51929045e-01, 2.66189843e-01, 2.81150103e-01, \
+	 2.96833098e-01, 3.13261658e-01, 3.30458194e-01, \
+	 3.48444581e-01, 3.67242008e-01, 3.86871010e-01, \
+	 4.07351047e-01, 4.28700656e-01, 4.50937301e-01, \
+	 4.74076986e-01, 4.98134524e-01, 5.23123264e-01, \
+	 5.49054801e-01, 5.75939417e-01, 6.03785276e-01, \
+	 6.32598996e-01, 6.62385404e-01, 6.93147182e-01, \
+	 7.24885464e-01, 7.57598996e-01, 7.91285276e-01, \
+	 8.25939417e-01, 8.61554861e-01, 8.98123205e-01, \
+	 9.35634553e-01, 9.74076986e-01, 1.01343727e+00, \
+	 1.05370069e+00, 1.09485114e+00, 1.13687098e+00, \
+	 1.17974198e+00, 1.22344458e+00, 1.26795816e+00, \
+	 1.31326163e+00, 1.35933316e+00, 1.40615010e+00, \
+	 1.45368981e+00, 1.50192916e+00, 1.55084455e+00, \
+	 1.60041261e+00, 1.65061009e+00, 1.70141327e+00, \
+	 1.75279915e+00, 1.80474472e+00, 1.85722709e+00, \
+	 1.91022420e+00, 1.96371388e+00, 2.01767516e+00, \
+	 2.07208657e+00, 2.12692809e+00, 2.18217969e+00, \
+	 2.23782229e+00, 2.29383731e+00, 2.35020661e+00, \
+	 2.40691280e+00, 2.46393943e+00, 2.52127028e+00, \
+	 2.57888985e+00, 2.63678312e+00, 2.69493628e+00, \
+	 2.75333548e+00, 2.81196761e+00, 2.87082052e+00, \
+	 2.92988205e+00, 2.98914146e+00, 3.04858732e+00, \
+	 3.10820985e+00, 3.16799903e+00, 3.22794580e+00, \
+	 3.28804135e+00, 3.34827733e+00, 3.40864563e+00, \
+	 3.46913910e+00, 3.52975035e+00, 3.59047294e+00, \
+	 3.65130019e+00, 3.71222615e+00, 3.77324557e+00, \
+	 3.83435225e+00, 3.89554191e+00, 3.95680928e+00, \
+	 4.01814985e+00, 4.07955980e+00, 4.14103413e+00, \
+	 4.20256996e+00, 4.26416349e+00, 4.32581091e+00, \
+	 4.38750982e+00, 4.44925594e+00, 4.51104784e+00, \
+	 4.57288170e+00, 4.63475609e+00, 4.69666767e+00, \
+	 4.75861454e+00, 4.82059479e+00, 4.88260603e+00, \
+	 4.94464684e+00, 5.00671530e+00, 5.06880999e+00, \
+	 5.13092852e+00, 5.19307041e+00, 5.25523376e+00, \
+	 5.31741762e+00, 5.37962008e+00, 5.44184065e+00, \
+	 5.50407839e+00, 5.56633186e+00, 5.62860012e+00, \
+	 5.69088221e+00, 5.75317764e+00, 5.81548548e+00, \
+	 5.87780476e+00, 5.94013500e+00, 6.00247574e+00, \
+	 6.06482601e+00, 6.12718487e+00, 6.18955278e+00, \
+	 6.25192881e+00, 6.31431198e+00, 6.37670231e+00, \
+	 6.43909931e+00, 6.50150251e+00, 6.56391144e+00, \
+	 6.62632608e+00, 6.68874550e+00, 6.75117016e+00, \
+	 6.81359911e+00, 6.87603283e+00, 6.93847036e+00, \
+	 7.00091171e+00, 7.06335640e+00, 7.12580442e+00, \
+	 7.18825579e+00, 7.25071001e+00, 7.31316710e+00, \
+	 7.37562656e+00, 7.43808842e+00, 7.50055313e+00, \
+	 7.56301928e+00, 7.62548780e+00, 7.68795824e+00, \
+	 7.75043058e+00, 7.81290436e+00, 7.87538004e+00, \
+	 7.93785715e+00, 8.00033569e+00}
+
+#define ACTIVATION_LUT_SOFTPLUS_SLOPE \
+	{2.16885819e-05, 2.29989237e-05, 2.44283001e-05, \
+	 2.60959496e-05, 2.77634244e-05, 2.95499049e-05, \
+	 3.15745419e-05, 3.34798824e-05, 3.56232049e-05, \
+	 3.78855621e-05, 4.03858139e-05, 4.30049258e-05, \
+	 4.58619907e-05, 4.87185898e-05, 5.18129673e-05, \
+	 5.51451230e-05, 5.88340336e-05, 6.25221874e-05, \
+	 6.65669795e-05, 7.08490843e-05, 7.54875364e-05, \
+	 8.02438008e-05, 8.54751561e-05, 9.09433002e-05, \
+	 9.67669766e-05, 1.03065046e-04, 1.09717948e-04, \
+	 1.16725801e-04, 1.24206999e-04, 1.32280169e-04, \
+	 1.40706776e-04, 1.49843749e-04, 1.59451505e-04, \
+	 1.69768464e-04, 1.80555508e-04, 1.92287145e-04, \
+	 2.04606215e-04, 2.17749039e-04, 2.31714686e-04, \
+	 2.46620504e-04, 2.62464397e-04, 2.79364176e-04, \
+	 2.97198538e-04, 3.16321850e-04, 3.36611643e-04, \
+	 3.58185265e-04, 3.81275080e-04, 4.05522995e-04, \
+	 4.31516673e-04, 4.59250994e-04, 4.88603022e-04, \
+	 5.19801863e-04, 5.52961603e-04, 5.88425435e-04, \
+	 6.25952147e-04, 6.65882602e-04, 7.08324835e-04, \
+	 7.53503293e-04, 8.01402144e-04, 8.52475874e-04, \
+	 9.06589441e-04, 9.64191742e-04, 1.02537684e-03, \
+	 1.09035335e-03, 1.15932710e-03, 1.23261288e-03, \
+	 1.31040812e-03, 1.39313936e-03, 1.48086809e-03, \
+	 1.57389790e-03, 1.67262927e-03, 1.77757256e-03, \
+	 1.88865326e-03, 2.00658664e-03, 2.13162974e-03, \
+	 2.26412714e-03, 2.40442157e-03, 2.55327672e-03, \
+	 2.71067023e-03, 2.87754834e-03, 3.05406749e-03, \
+	 3.24079394e-03, 3.43828276e-03, 3.64714116e-03, \
+	 3.86774912e-03, 4.10086662e-03, 4.34689224e-03, \
+	 4.60662693e-03, 4.88044322e-03, 5.16926497e-03, \
+	 5.47344983e-03, 5.79367578e-03, 6.13068789e-03, \
+	 6.48497045e-03, 6.85743988e-03, 7.24836439e-03, \
+	 7.65854120e-03, 8.08849931e-03, 8.53890181e-03, \
+	 9.01021063e-03, 9.50282812e-03, 1.00176185e-02, \
+	 1.05545223e-02, 1.11141652e-02, 1.16966963e-02, \
+	 1.23025924e-02, 1.29318684e-02, 1.35845542e-02, \
+	 1.42607987e-02, 1.49602592e-02, 1.56829953e-02, \
+	 1.64285600e-02, 1.71965361e-02, 1.79863870e-02, \
+	 1.87974274e-02, 1.96290016e-02, 2.04800367e-02, \
+	 2.13496089e-02, 2.22366452e-02, 2.31396854e-02, \
+	 2.40575373e-02, 2.49887407e-02, 2.59315372e-02, \
+	 2.68846154e-02, 2.78458595e-02, 2.88137197e-02, \
+	 2.97864079e-02, 3.07617784e-02, 3.17382812e-02, \
+	 3.27135324e-02, 3.36862803e-02, 3.46541405e-02, \
+	 3.56154442e-02, 3.65683436e-02, 3.75113487e-02, \
+	 3.84424329e-02, 3.93602848e-02, 4.02634144e-02, \
+	 4.11504507e-02, 4.20198441e-02, 4.28709984e-02, \
+	 4.37026024e-02, 4.45135832e-02, 4.53034639e-02, \
+	 4.60715294e-02, 4.68169451e-02, 4.75397110e-02, \
+	 4.82393503e-02, 4.89153862e-02, 4.95680571e-02, \
+	 5.01974821e-02, 5.08031845e-02, 5.13858795e-02, \
+	 5.19455671e-02, 5.24823666e-02, 5.29971123e-02, \
+	 5.34896851e-02, 5.39612770e-02, 5.44114113e-02, \
+	 5.48415184e-02, 5.52515984e-02, 5.56426048e-02, \
+	 5.60150146e-02, 5.63693047e-02, 5.67061901e-02, \
+	 5.70266247e-02, 5.73308468e-02, 5.76195717e-02, \
+	 5.78932762e-02, 5.81531525e-02, 5.83992004e-02, \
+	 5.86321354e-02, 5.88529110e-02, 5.90615273e-02, \
+	 5.92594147e-02, 5.94458580e-02, 5.96225262e-02, \
+	 5.97891808e-02, 5.99467754e-02, 6.00955486e-02, \
+	 6.02359772e-02, 6.03682995e-02, 6.04934692e-02, \
+	 6.06112480e-02, 6.07225895e-02, 6.08272552e-02, \
+	 6.09259605e-02, 6.10194206e-02, 6.11066818e-02, \
+	 6.11896515e-02, 6.12673759e-02, 6.13405704e-02, \
+	 6.14099503e-02, 6.14743233e-02, 6.15358353e-02, \
+	 6.15935326e-02, 6.16474152e-02, 6.16989136e-02, \
+	 6.17461205e-02, 6.17918968e-02, 6.18338585e-02, \
+	 6.18743896e-02, 6.19115829e-02, 6.19468689e-02, \
+	 6.19802475e-02, 6.20112419e-02, 6.20408058e-02, \
+	 6.20684624e-02, 6.20946884e-02, 6.21185303e-02, \
+	 6.21418953e-02, 6.21633530e-02, 6.21838570e-02, \
+	 6.22024536e-02, 6.22205734e-02, 6.22377396e-02, \
+	 6.22534752e-02, 6.22682571e-02, 6.22820854e-02, \
+	 6.22954369e-02, 6.23078346e-02, 6.23192787e-02, \
+	 6.23302460e-02, 6.23407364e-02, 6.23502731e-02, \
+	 6.23588562e-02, 6.23679161e-02, 6.23760223e-02, \
+	 6.23831749e-02, 6.23903275e-02, 6.23970032e-02, \
+	 6.24032021e-02, 6.24089241e-02, 6.24146461e-02, \
+	 6.24194145e-02, 6.24246597e-02, 6.24289513e-02, \
+	 6.24337196e-02, 6.24375343e-02, 6.24413490e-02, \
+	 6.24446869e-02, 6.24480247e-02, 6.24513626e-02, \
+	 6.24542236e-02, 6.24570847e-02, 6.24594688e-02, \
+	 6.24618530e-02, 6.24647141e-02, 6.24661446e-02, \
+	 6.24685287e-02, 6.24704361e-02, 6.24723434e-02, \
+	 6.24737740e-02, 6.24756813e-02, 6.24771118e-02, \
+	 6.24785423e-02, 0.00000000e+00}
+
+#endif
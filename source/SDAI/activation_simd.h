@@ -0,0 +1,283 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __ACTIVATION_SIMD_H__
+#define __ACTIVATION_SIMD_H__
+#include <math.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*
+ * @note: the vector kernels of exp, sigmoid, tanh and softplus used by activation_apply in C simulation,
+ * 	they are never seen by the synthesis. exp and log use the Cephes polynomials, 8 floats are processed
+ * 	at once with AVX2, 4 with SSE2 and the rest with the scalar functions of math.h
+ */
+namespace SDAI
+{
+
+#if defined(__SSE2__)
+/*
+ * @note: exp of 4 floats
+ */
+inline __m128 simd_exp_ps(__m128 x)
+{
+	x = _mm_min_ps(x, _mm_set1_ps(88.3762626647949f));
+	x = _mm_max_ps(x, _mm_set1_ps(-88.3762626647949f));
+
+	/* exp(x) = 2^n * exp(g), n = round(x / log(2)) */
+	__m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+	__m128 tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+	fx = _mm_sub_ps(tmp, _mm_and_ps(_mm_cmpgt_ps(tmp, fx), _mm_set1_ps(1.0f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+	__m128 z = _mm_mul_ps(x, x);
+	__m128 y = _mm_set1_ps(1.9875691500E-4f);
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507E-3f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073E-3f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894E-2f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201E-1f));
+	y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.0f));
+
+	__m128i n = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f)), 23);
+	return _mm_mul_ps(y, _mm_castsi128_ps(n));
+}
+
+/*
+ * @note: log of 4 positive floats
+ */
+inline __m128 simd_log_ps(__m128 x)
+{
+	x = _mm_max_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x00800000)));
+
+	/* x = m * 2^e, m in [0.5, 1) */
+	__m128i emm0 = _mm_srli_epi32(_mm_castps_si128(x), 23);
+	x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(~0x7f800000)));
+	x = _mm_or_ps(x, _mm_set1_ps(0.5f));
+	__m128 e = _mm_add_ps(_mm_cvtepi32_ps(_mm_sub_epi32(emm0, _mm_set1_epi32(0x7f))), _mm_set1_ps(1.0f));
+
+	/* move m to [sqrt(0.5), sqrt(2)) */
+	__m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+	__m128 tmp = _mm_and_ps(x, mask);
+	x = _mm_sub_ps(x, _mm_set1_ps(1.0f));
+	e = _mm_sub_ps(e, _mm_and_ps(_mm_set1_ps(1.0f), mask));
+	x = _mm_add_ps(x, tmp);
+
+	__m128 z = _mm_mul_ps(x, x);
+	__m128 y = _mm_set1_ps(7.0376836292E-2f);
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174E-1f));
+	y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+	y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+	y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	x = _mm_add_ps(x, y);
+	return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
+#endif
+
+#if defined(__AVX2__)
+/*
+ * @note: exp of 8 floats
+ */
+inline __m256 simd_exp_ps(__m256 x)
+{
+	x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+	x = _mm256_max_ps(x, _mm256_set1_ps(-88.3762626647949f));
+
+	/* exp(x) = 2^n * exp(g), n = round(x / log(2)) */
+	__m256 fx = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)), _mm256_set1_ps(0.5f)));
+	x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(0.693359375f)));
+	x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(-2.12194440e-4f)));
+
+	__m256 z = _mm256_mul_ps(x, x);
+	__m256 y = _mm256_set1_ps(1.9875691500E-4f);
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.3981999507E-3f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(8.3334519073E-3f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(4.1665795894E-2f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.6666665459E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(5.0000001201E-1f));
+	y = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(y, z), x), _mm256_set1_ps(1.0f));
+
+	__m256i n = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(0x7f)), 23);
+	return _mm256_mul_ps(y, _mm256_castsi256_ps(n));
+}
+
+/*
+ * @note: log of 8 positive floats
+ */
+inline __m256 simd_log_ps(__m256 x)
+{
+	x = _mm256_max_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x00800000)));
+
+	/* x = m * 2^e, m in [0.5, 1) */
+	__m256i emm0 = _mm256_srli_epi32(_mm256_castps_si256(x), 23);
+	x = _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(~0x7f800000)));
+	x = _mm256_or_ps(x, _mm256_set1_ps(0.5f));
+	__m256 e = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(emm0, _mm256_set1_epi32(0x7f))), _mm256_set1_ps(1.0f));
+
+	/* move m to [sqrt(0.5), sqrt(2)) */
+	__m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OS);
+	__m256 tmp = _mm256_and_ps(x, mask);
+	x = _mm256_sub_ps(x, _mm256_set1_ps(1.0f));
+	e = _mm256_sub_ps(e, _mm256_and_ps(_mm256_set1_ps(1.0f), mask));
+	x = _mm256_add_ps(x, tmp);
+
+	__m256 z = _mm256_mul_ps(x, x);
+	__m256 y = _mm256_set1_ps(7.0376836292E-2f);
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-1.1514610310E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.1676998740E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-1.2420140846E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.4249322787E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-1.6668057665E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(2.0000714765E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(-2.4999993993E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(3.3333331174E-1f));
+	y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+	y = _mm256_add_ps(y, _mm256_mul_ps(e, _mm256_set1_ps(-2.12194440e-4f)));
+	y = _mm256_sub_ps(y, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+	x = _mm256_add_ps(x, y);
+	return _mm256_add_ps(x, _mm256_mul_ps(e, _mm256_set1_ps(0.693359375f)));
+}
+#endif
+
+/*
+ * @note: the vector kernels on an array of n floats, in place
+ */
+inline void simd_sigmoid(float *x, int n)
+{
+	int i = 0;
+#if defined(__AVX2__)
+	for( ; i < (n & ~7); i += 8)
+	{
+		__m256 v = _mm256_loadu_ps(&x[i]);
+		__m256 e = simd_exp_ps(_mm256_sub_ps(_mm256_setzero_ps(), v));
+		_mm256_storeu_ps(&x[i], _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_add_ps(e, _mm256_set1_ps(1.0f))));
+	}
+#endif
+#if defined(__SSE2__)
+	for( ; i < (n & ~3); i += 4)
+	{
+		__m128 v = _mm_loadu_ps(&x[i]);
+		__m128 e = simd_exp_ps(_mm_sub_ps(_mm_setzero_ps(), v));
+		_mm_storeu_ps(&x[i], _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(e, _mm_set1_ps(1.0f))));
+	}
+#endif
+	for( ; i < n; i++)
+	{
+		x[i] = 1.0f/(1.0f + expf(-x[i]));
+	}
+}
+
+/*
+ * @note: tanh(x) = 1 - 2 / (exp(2x) + 1) loses the relative precision for a small |x|,
+ * 	so |x| < 0.625 uses the odd polynomial of the Cephes tanhf instead
+ */
+#if defined(__SSE2__)
+inline __m128 simd_tanh_small_ps(__m128 x)
+{
+	__m128 z = _mm_mul_ps(x, x);
+	__m128 y = _mm_set1_ps(-5.70498872745E-3f);
+	y = _mm_add_ps(_mm_mul_ps(y, z), _mm_set1_ps(2.06390887954E-2f));
+	y = _mm_add_ps(_mm_mul_ps(y, z), _mm_set1_ps(-5.37397155531E-2f));
+	y = _mm_add_ps(_mm_mul_ps(y, z), _mm_set1_ps(1.33314422036E-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, z), _mm_set1_ps(-3.33332819422E-1f));
+	return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(y, z), x), x);
+}
+#endif
+
+#if defined(__AVX2__)
+inline __m256 simd_tanh_small_ps(__m256 x)
+{
+	__m256 z = _mm256_mul_ps(x, x);
+	__m256 y = _mm256_set1_ps(-5.70498872745E-3f);
+	y = _mm256_add_ps(_mm256_mul_ps(y, z), _mm256_set1_ps(2.06390887954E-2f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, z), _mm256_set1_ps(-5.37397155531E-2f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, z), _mm256_set1_ps(1.33314422036E-1f));
+	y = _mm256_add_ps(_mm256_mul_ps(y, z), _mm256_set1_ps(-3.33332819422E-1f));
+	return _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(y, z), x), x);
+}
+#endif
+
+inline void simd_tanh(float *x, int n)
+{
+	int i = 0;
+#if defined(__AVX2__)
+	for( ; i < (n & ~7); i += 8)
+	{
+		__m256 v = _mm256_loadu_ps(&x[i]);
+		__m256 e = simd_exp_ps(_mm256_add_ps(v, v));
+		__m256 r = _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, _mm256_set1_ps(1.0f))));
+		__m256 small = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), v), _mm256_set1_ps(0.625f), _CMP_LT_OS);
+		_mm256_storeu_ps(&x[i], _mm256_blendv_ps(r, simd_tanh_small_ps(v), small));
+	}
+#endif
+#if defined(__SSE2__)
+	for( ; i < (n & ~3); i += 4)
+	{
+		__m128 v = _mm_loadu_ps(&x[i]);
+		__m128 e = simd_exp_ps(_mm_add_ps(v, v));
+		__m128 r = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_div_ps(_mm_set1_ps(2.0f), _mm_add_ps(e, _mm_set1_ps(1.0f))));
+		__m128 small = _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), v), _mm_set1_ps(0.625f));
+		_mm_storeu_ps(&x[i], _mm_or_ps(_mm_and_ps(small, simd_tanh_small_ps(v)), _mm_andnot_ps(small, r)));
+	}
+#endif
+	for( ; i < n; i++)
+	{
+		x[i] = tanhf(x[i]);
+	}
+}
+
+/*
+ * @note: softplus(x) = max(x, 0) + log(1 + exp(-|x|)), which does not overflow for a large x,
+ * 	log(1 + e) is calculated as log(u) * e / (u - 1) with u = 1 + e, so e is not lost when 1 + e rounds to 1
+ */
+inline void simd_softplus(float *x, int n)
+{
+	int i = 0;
+#if defined(__AVX2__)
+	for( ; i < (n & ~7); i += 8)
+	{
+		__m256 v = _mm256_loadu_ps(&x[i]);
+		__m256 a = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+		__m256 e = simd_exp_ps(_mm256_sub_ps(_mm256_setzero_ps(), a));
+		__m256 u = _mm256_add_ps(e, _mm256_set1_ps(1.0f));
+		__m256 d = _mm256_sub_ps(u, _mm256_set1_ps(1.0f));
+		__m256 l = _mm256_div_ps(_mm256_mul_ps(simd_log_ps(u), e), d);
+		l = _mm256_blendv_ps(l, e, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_EQ_OQ));
+		_mm256_storeu_ps(&x[i], _mm256_add_ps(_mm256_max_ps(v, _mm256_setzero_ps()), l));
+	}
+#endif
+#if defined(__SSE2__)
+	for( ; i < (n & ~3); i += 4)
+	{
+		__m128 v = _mm_loadu_ps(&x[i]);
+		__m128 a = _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+		__m128 e = simd_exp_ps(_mm_sub_ps(_mm_setzero_ps(), a));
+		__m128 u = _mm_add_ps(e, _mm_set1_ps(1.0f));
+		__m128 d = _mm_sub_ps(u, _mm_set1_ps(1.0f));
+		__m128 l = _mm_div_ps(_mm_mul_ps(simd_log_ps(u), e), d);
+		__m128 one = _mm_cmpeq_ps(d, _mm_setzero_ps());
+		l = _mm_or_ps(_mm_and_ps(one, e), _mm_andnot_ps(one, l));
+		_mm_storeu_ps(&x[i], _mm_add_ps(_mm_max_ps(v, _mm_setzero_ps()), l));
+	}
+#endif
+	for( ; i < n; i++)
+	{
+		x[i] = (x[i] > 0 ? x[i] : 0) + log1pf(expf(-fabsf(x[i])));
+	}
+}
+
+}
+
+#endif
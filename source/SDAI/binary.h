@@ -0,0 +1,153 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __BINARY_H__
+#define __BINARY_H__
+#include <math.h>
+#include <assert.h>
+#include "configure.h"
+
+namespace SDAI
+{
+/*
+ * @note: the binarized values, +1 is kept as the bit 1 and -1 as the bit 0, BINARY_WORD_BITS values are packed into a TYPE_BWORD
+ * 	the dot product of N packed values is N - 2 * popcount(a ^ w), the unused bits of the last word are 0 in both a and w
+ * 	and do not count
+ */
+#define BINARY_WORD_BITS		32
+
+/*
+ * @note: the number of words to pack N values
+ */
+#define BINARY_NB_WORD(N)		(((N) + BINARY_WORD_BITS - 1) / BINARY_WORD_BITS)
+
+/*
+ * @note: the epsilon of the folded batch normalization, the default of Keras
+ */
+#define BINARY_BN_EPSILON		1e-3
+
+/*
+ * @note: the number of bits 1 in a word, the adder tree is the same in C simulation and in the synthesis
+ */
+inline int binary_popcount(TYPE_BWORD x)
+{
+#pragma HLS INLINE
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	x = (x + (x >> 4)) & 0x0F0F0F0F;
+	x += x >> 8;
+	x += x >> 16;
+	return x & 0x3F;
+}
+
+/*
+ * @note: binarize and pack N values, the value x is +1 when x >= 0,
+ * 	the values are N / GROUP groups of GROUP and each group starts at a new word, e.g. the channels of a pixel
+ */
+template<int N, int GROUP, typename T>
+void binary_pack(const T x[N], TYPE_BWORD w[N / GROUP * BINARY_NB_WORD(GROUP)])
+{
+	assert(N % GROUP == 0);
+	for( int g = 0; g < N / GROUP; g++)
+	{
+		for( int b = 0; b < BINARY_NB_WORD(GROUP); b++)
+		{
+#pragma HLS pipeline
+			TYPE_BWORD word = 0;
+			for( int i = 0; i < BINARY_WORD_BITS; i++)
+			{
+				int j = b * BINARY_WORD_BITS + i;
+				if( j < GROUP && x[g * GROUP + j] >= 0 )
+					word |= (TYPE_BWORD)1 << i;
+			}
+			w[g * BINARY_NB_WORD(GROUP) + b] = word;
+		}
+	}
+}
+
+/*
+ * @note: unpack N values to +1 and -1 in the layout of binary_pack, it converts the output of the last binary layer
+ */
+template<int N, int GROUP, typename T>
+void binary_unpack(const TYPE_BWORD w[N / GROUP * BINARY_NB_WORD(GROUP)], T x[N])
+{
+	assert(N % GROUP == 0);
+	for( int g = 0; g < N / GROUP; g++)
+	{
+		for( int j = 0; j < GROUP; j++)
+		{
+#pragma HLS pipeline
+			TYPE_BWORD word = w[g * BINARY_NB_WORD(GROUP) + j / BINARY_WORD_BITS];
+			x[g * GROUP + j] = (word >> (j % BINARY_WORD_BITS)) & 1 ? 1 : -1;
+		}
+	}
+}
+
+/*
+ * @note: binarize the NB_IN x NB_OUT row major float weight, the column j is packed into weight[j * NB_WORD ...]
+ * 	in the layout of binary_pack with GROUP, so that it lines up with the packed input
+ */
+template<int NB_IN, int NB_OUT, int GROUP>
+void binary_pack_weight(const TYPE_T *WEIGHT, TYPE_BWORD *weight)
+{
+	const int NB_WORD = NB_IN / GROUP * BINARY_NB_WORD(GROUP);
+	TYPE_T col[NB_IN];
+	for( int j = 0; j < NB_OUT; j++)
+	{
+		for( int i = 0; i < NB_IN; i++)
+			col[i] = WEIGHT[i * NB_OUT + j];
+		binary_pack<NB_IN, GROUP>(col, &weight[j * NB_WORD]);
+	}
+}
+
+/*
+ * @note: fold the bias and the batch normalization of each output into an integer threshold on the dot product of N values,
+ * 	BATCHNORM is the 4 x NB_OUT array {gamma, beta, mean, variance} as saved by Keras, a NULL BIAS or BATCHNORM is left out,
+ * 	the output is +1 when dot >= threshold if positive, or when dot <= threshold if not
+ */
+template<int N, int NB_OUT>
+void binary_threshold(const TYPE_T *BIAS, const TYPE_T *BATCHNORM, TYPE_INT32 threshold[NB_OUT], bool positive[NB_OUT])
+{
+	for( int j = 0; j < NB_OUT; j++)
+	{
+		/* the output is +1 when gamma * (dot + bias - mean) / sigma + beta >= 0 */
+		double bias = BIAS ? (double)BIAS[j] : 0.0;
+		double gamma = 1.0, beta = 0.0, mean = 0.0, sigma = 1.0;
+		if( BATCHNORM )
+		{
+			gamma = BATCHNORM[j];
+			beta = BATCHNORM[NB_OUT + j];
+			mean = BATCHNORM[2 * NB_OUT + j];
+			sigma = sqrt((double)BATCHNORM[3 * NB_OUT + j] + BINARY_BN_EPSILON);
+		}
+
+		if( gamma == 0 )
+		{
+			/* a constant output, the dot product is always in [-N, N] */
+			positive[j] = true;
+			threshold[j] = beta >= 0 ? -N : N + 1;
+			continue;
+		}
+
+		double t = mean - bias - beta * sigma / gamma;
+		if( t > N + 1 )
+			t = N + 1;
+		if( t < -N - 1 )
+			t = -N - 1;
+		positive[j] = gamma > 0;
+		threshold[j] = (TYPE_INT32)(gamma > 0 ? ceil(t) : floor(t));
+	}
+}
+
+/*
+ * @note: the threshold activation of a dot product
+ */
+inline bool binary_activation(TYPE_INT32 dot, TYPE_INT32 threshold, bool positive)
+{
+#pragma HLS INLINE
+	return positive ? dot >= threshold : dot <= threshold;
+}
+
+}
+
+#endif
@@ -0,0 +1,423 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __CALIBRATION_H__
+#define __CALIBRATION_H__
+#include "configure.h"
+
+/*
+ * @note: the calibration is only used in C simulation, the synthesis never sees the hooks of the layers
+ */
+#if CALIBRATION && !defined(__SYNTHESIS__)
+#define CALIBRATION_HOST	1
+#else
+#define CALIBRATION_HOST	0
+#endif
+
+#if CALIBRATION_HOST
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace SDAI
+{
+/*
+ * @note: the post-training calibration of the fixed point formats, the network is run over the validation samples
+ * 	in float (CALIBRATION_RECORD) while every layer records its weights and outputs, then a format ap_fixed<W, I, AP_RND, AP_SAT>
+ * 	is recommended for the outputs and the weights of each layer, and the network is run again with its weights and outputs
+ * 	rounded to those formats (CALIBRATION_QUANTIZE) to measure the accuracy, e.g. in main.cpp of LeNet_v2
+ *
+ * 		calibration().begin(CALIBRATION_RECORD);
+ * 		Neural(sample, result, N);
+ * 		calibration().score(result, std_result, N);
+ * 		for( int w = 16; w >= 8; w -= 2)
+ * 		{
+ * 			calibration().recommend(w, w);
+ * 			calibration().begin(CALIBRATION_QUANTIZE);
+ * 			Neural(sample, result, N);
+ * 			calibration().score(result, std_result, N);
+ * 			calibration().report(stdout);
+ * 		}
+ *
+ * 	a layer is identified by the address of its weight, so it is the same layer when it is constructed again in the next
+ * 	call of Neural(), the layers have to be constructed after begin()
+ * 	the pooling and reshape layers do not widen the range, so they take the format of the layer before them
+ */
+#define CALIBRATION_MAX_LAYER		64
+#define CALIBRATION_NAME_SIZE		32
+
+/*
+ * @note: the histogram of |x| has a bin per power of two, bin b counts 2^(b - CALIBRATION_EXP_BIAS) <= |x| < 2^(b - CALIBRATION_EXP_BIAS + 1)
+ */
+#define CALIBRATION_NB_BIN			64
+#define CALIBRATION_EXP_BIAS		32
+
+typedef enum{CALIBRATION_OFF, CALIBRATION_RECORD, CALIBRATION_QUANTIZE}CALIBRATION_PHASE;
+
+/*
+ * @note: the range and the histogram of a set of values
+ */
+struct Calibration_Stat
+{
+	double	min;
+	double	max;
+	long	count;
+	long	zero;
+	long	hist[CALIBRATION_NB_BIN];
+
+	void clear()
+	{
+		min = 0;
+		max = 0;
+		count = 0;
+		zero = 0;
+		for( int b = 0; b < CALIBRATION_NB_BIN; b++)
+			hist[b] = 0;
+	}
+
+	template<typename T>
+	void observe(const T *x, int n)
+	{
+		for( int i = 0; i < n; i++)
+		{
+			double v = (double)x[i];
+			if( count == 0 || v < min )
+				min = v;
+			if( count == 0 || v > max )
+				max = v;
+			count++;
+
+			if( v == 0 )
+			{
+				zero++;
+				continue;
+			}
+			int e;
+			frexp(v, &e);
+			int b = e - 1 + CALIBRATION_EXP_BIAS;
+			b = b < 0 ? 0 : (b >= CALIBRATION_NB_BIN ? CALIBRATION_NB_BIN - 1 : b);
+			hist[b]++;
+		}
+	}
+
+	/*
+	 * @note: the integer bits I, with the sign bit, so that a coverage fraction of the values is inside [-2^(I-1), 2^(I-1))
+	 */
+	int int_bits(double coverage) const
+	{
+		long need = (long)ceil(coverage * count);
+		long n = zero;
+		int b = 0;
+		for( ; b < CALIBRATION_NB_BIN - 1 && n + hist[b] < need; b++)
+			n += hist[b];
+		if( n >= need )
+			return 1;
+
+		/* all the values of bin b are below 2^(b - CALIBRATION_EXP_BIAS + 1) */
+		return b - CALIBRATION_EXP_BIAS + 2;
+	}
+};
+
+/*
+ * @note: the format ap_fixed<W, I, AP_RND, AP_SAT>, W = 0 means that the values are not rounded
+ */
+struct Calibration_Format
+{
+	int		W;
+	int		I;
+};
+
+/*
+ * @note: round x to the format as ap_fixed<W, I, AP_RND, AP_SAT> does
+ */
+inline double calibration_quantize(double x, Calibration_Format f)
+{
+	if( f.W == 0 )
+		return x;
+	double step = ldexp(1.0, f.I - f.W);
+	double hi = ldexp(1.0, f.I - 1) - step;
+	double lo = -ldexp(1.0, f.I - 1);
+	double q = floor(x / step + 0.5) * step;
+	return q > hi ? hi : (q < lo ? lo : q);
+}
+
+struct Calibration_Layer
+{
+	char				name[CALIBRATION_NAME_SIZE];
+	const void			*key;
+	Calibration_Stat	data;
+	Calibration_Stat	weight;
+	Calibration_Format	data_fmt;
+	Calibration_Format	weight_fmt;
+
+	/* the weight is recorded by the first construction of the layer in CALIBRATION_RECORD */
+	bool				weight_open;
+
+	/* the rounded copy of a weight streamed from DDR, rebuilt after recommend() */
+	void				*copy;
+	bool				copy_valid;
+};
+
+class Calibration
+{
+public:
+	Calibration()
+	{
+		phase = CALIBRATION_OFF;
+		nb_layer = 0;
+		data_width = 0;
+		weight_width = 0;
+		coverage = 1.0;
+		float_accuracy = -1;
+		fixed_accuracy = -1;
+	}
+
+public:
+	CALIBRATION_PHASE	phase;
+	int					nb_layer;
+	Calibration_Layer	layer[CALIBRATION_MAX_LAYER];
+
+	/* the arguments of the last recommend() */
+	int					data_width;
+	int					weight_width;
+	double				coverage;
+
+	/* the accuracy of the last score() in each phase, -1 before the first one */
+	double				float_accuracy;
+	double				fixed_accuracy;
+
+public:
+	/*
+	 * @note: start recording or quantizing, the statistics of CALIBRATION_RECORD are cleared before it
+	 */
+	void begin(CALIBRATION_PHASE p)
+	{
+		phase = p;
+		if( p != CALIBRATION_RECORD )
+			return;
+		for( int i = 0; i < nb_layer; i++)
+		{
+			layer[i].data.clear();
+			layer[i].weight.clear();
+		}
+	}
+
+	void end()
+	{
+		phase = CALIBRATION_OFF;
+	}
+
+	/*
+	 * @note: the index of the layer with the weight key, a new one is added the first time, -1 when the calibration is off
+	 */
+	int find(const char *name, const void *key)
+	{
+		if( phase == CALIBRATION_OFF )
+			return -1;
+		for( int i = 0; i < nb_layer; i++)
+		{
+			if( layer[i].key == key )
+			{
+				layer[i].weight_open = (layer[i].weight.count == 0);
+				return i;
+			}
+		}
+		if( nb_layer == CALIBRATION_MAX_LAYER )
+			return -1;
+
+		Calibration_Layer &l = layer[nb_layer];
+		strncpy(l.name, name, CALIBRATION_NAME_SIZE - 1);
+		l.name[CALIBRATION_NAME_SIZE - 1] = 0;
+		l.key = key;
+		l.data.clear();
+		l.weight.clear();
+		l.data_fmt.W = l.data_fmt.I = 0;
+		l.weight_fmt.W = l.weight_fmt.I = 0;
+		l.weight_open = true;
+		l.copy = 0;
+		l.copy_valid = false;
+		return nb_layer++;
+	}
+
+	/*
+	 * @note: recommend the formats of data_width and weight_width bits, the integer bits keep a coverage fraction of the recorded values
+	 */
+	void recommend(int data_width, int weight_width, double coverage = 1.0)
+	{
+		this->data_width = data_width;
+		this->weight_width = weight_width;
+		this->coverage = coverage;
+		for( int i = 0; i < nb_layer; i++)
+		{
+			Calibration_Layer &l = layer[i];
+			l.data_fmt = format(l.data, data_width);
+			l.weight_fmt = format(l.weight, weight_width);
+			l.copy_valid = false;
+		}
+	}
+
+	/*
+	 * @note: the weight of a layer, recorded once in CALIBRATION_RECORD and rounded in place in CALIBRATION_QUANTIZE,
+	 * 	it is called after find() in the constructor, once for each weight array of the layer
+	 */
+	template<typename T>
+	void weight(int id, T *w, int n)
+	{
+		if( id < 0 )
+			return;
+		Calibration_Layer &l = layer[id];
+		if( phase == CALIBRATION_RECORD && l.weight_open )
+			l.weight.observe(w, n);
+		if( phase == CALIBRATION_QUANTIZE )
+		{
+			for( int i = 0; i < n; i++)
+				w[i] = calibration_quantize((double)w[i], l.weight_fmt);
+		}
+	}
+
+	/*
+	 * @note: the weight streamed from DDR, the rounded copy is returned in CALIBRATION_QUANTIZE so the DDR buffer is not changed
+	 */
+	template<typename T>
+	volatile T *weight_stream(int id, volatile T *w, int n)
+	{
+		if( id < 0 )
+			return w;
+		Calibration_Layer &l = layer[id];
+		if( phase == CALIBRATION_RECORD && l.weight.count == 0 )
+			l.weight.observe((const T *)w, n);
+		if( phase != CALIBRATION_QUANTIZE )
+			return w;
+
+		if( !l.copy )
+			l.copy = new T[n];
+		T *copy = (T *)l.copy;
+		if( !l.copy_valid )
+		{
+			for( int i = 0; i < n; i++)
+				copy[i] = calibration_quantize((double)w[i], l.weight_fmt);
+			l.copy_valid = true;
+		}
+		return copy;
+	}
+
+	/*
+	 * @note: the output of a layer, recorded in CALIBRATION_RECORD and rounded in place in CALIBRATION_QUANTIZE
+	 */
+	template<typename T>
+	void data(int id, T *x, int n)
+	{
+		if( id < 0 )
+			return;
+		Calibration_Layer &l = layer[id];
+		if( phase == CALIBRATION_RECORD )
+			l.data.observe(x, n);
+		if( phase == CALIBRATION_QUANTIZE )
+		{
+			for( int i = 0; i < n; i++)
+				x[i] = calibration_quantize((double)x[i], l.data_fmt);
+		}
+	}
+
+	/*
+	 * @note: the accuracy of the categories of N samples, it is kept as the accuracy of the current phase
+	 */
+	double score(const TYPE_PINT *result, const TYPE_PINT *std_result, int N)
+	{
+		int n_right = 0;
+		for( int i = 0; i < N; i++)
+		{
+			if( result[i] == std_result[i] )
+				n_right++;
+		}
+		double rate = N > 0 ? (double)n_right / N : 0;
+		if( phase == CALIBRATION_QUANTIZE )
+			fixed_accuracy = rate;
+		else
+			float_accuracy = rate;
+		return rate;
+	}
+
+	/*
+	 * @note: print the range, the histogram and the format of every layer, the typedefs for the DATA_T and WEIGHT_T
+	 * 	parameters of the layers, and the accuracy
+	 */
+	void report(FILE *fp)
+	{
+		fprintf(fp, "calibration of %d layers, data width %d, weight width %d, coverage %g\n", nb_layer, data_width, weight_width, coverage);
+		fprintf(fp, "%3s %-24s %12s %12s %8s %12s %12s %8s\n", "id", "layer", "data min", "data max", "<W,I>", "weight min", "weight max", "<W,I>");
+		for( int i = 0; i < nb_layer; i++)
+		{
+			Calibration_Layer &l = layer[i];
+			fprintf(fp, "%3d %-24s %12g %12g   <%2d,%2d> %12g %12g   <%2d,%2d>\n", i, l.name,
+					l.data.min, l.data.max, l.data_fmt.W, l.data_fmt.I,
+					l.weight.min, l.weight.max, l.weight_fmt.W, l.weight_fmt.I);
+		}
+
+		fprintf(fp, "histogram of |x|, the count of each power of two 2^e <= |x| < 2^(e+1)\n");
+		for( int i = 0; i < nb_layer; i++)
+		{
+			histogram(fp, i, "data", layer[i].data);
+			histogram(fp, i, "weight", layer[i].weight);
+		}
+
+		for( int i = 0; i < nb_layer; i++)
+		{
+			Calibration_Layer &l = layer[i];
+			if( l.data_fmt.W > 0 )
+				fprintf(fp, "typedef TYPE_FIXED(%d, %d, AP_RND, AP_SAT)\t\t%s_%d_DATA_T;\n", l.data_fmt.W, l.data_fmt.I, l.name, i);
+			if( l.weight_fmt.W > 0 )
+				fprintf(fp, "typedef TYPE_FIXED(%d, %d, AP_RND, AP_SAT)\t\t%s_%d_WEIGHT_T;\n", l.weight_fmt.W, l.weight_fmt.I, l.name, i);
+		}
+
+		if( float_accuracy >= 0 )
+			fprintf(fp, "float accuracy %g\n", float_accuracy);
+		if( fixed_accuracy >= 0 )
+			fprintf(fp, "fixed accuracy %g\n", fixed_accuracy);
+	}
+
+private:
+	/*
+	 * @note: the format of width bits for the recorded values, the integer bits are kept in [1, width]
+	 */
+	Calibration_Format format(const Calibration_Stat &s, int width)
+	{
+		Calibration_Format f;
+		f.W = 0;
+		f.I = 0;
+		if( s.count == 0 || width <= 0 )
+			return f;
+		int I = s.int_bits(coverage);
+		f.W = width;
+		f.I = I < 1 ? 1 : (I > width ? width : I);
+		return f;
+	}
+
+	void histogram(FILE *fp, int id, const char *what, const Calibration_Stat &s)
+	{
+		if( s.count == 0 )
+			return;
+		fprintf(fp, "%3d %-6s zero:%ld", id, what, s.zero);
+		for( int b = 0; b < CALIBRATION_NB_BIN; b++)
+		{
+			if( s.hist[b] )
+				fprintf(fp, " 2^%d:%ld", b - CALIBRATION_EXP_BIAS, s.hist[b]);
+		}
+		fprintf(fp, "\n");
+	}
+};
+
+/*
+ * @note: the calibration shared by all the layers
+ */
+inline Calibration &calibration()
+{
+	static Calibration c;
+	return c;
+}
+
+}
+
+#endif
+
+#endif
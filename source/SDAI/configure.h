@@ -5,6 +5,7 @@
 #ifndef __CONFIGURE_H__
 #define __CONFIGURE_H__
 #include <ap_fixed.h>
+#include "fixed.h"
 
 namespace SDAI
 {
@@ -37,25 +38,104 @@ namespace SDAI
 #define	OPT_NONE								0
 #define	OPT_MEM									1
 #define OPT_BUFFER								2
+#define OPT_STREAM								3
 
 #define CONVOLUTION1D_OPT_MODE					OPT_MEM
 #define POOLING1D_OPT_MODE						OPT_NONE
+#ifndef CONVOLUTION2D_OPT_MODE
 #define CONVOLUTION2D_OPT_MODE					OPT_MEM
+#endif
 #define POOLING2D_OPT_MODE						OPT_MEM
+#define DENSE_OPT_MODE							OPT_BUFFER
+
+/*
+ * @note: configure the line buffer and window buffer of OPT_BUFFER, 1 for the circular buffers that rotate a head index,
+ * 	0 for the buffers that shift the lines
+ */
+#define OPT_BUFFER_CIRCULAR						1
+
+/*
+ * @note: configure the recurrent layers, 1 to calculate the input weight of all the timesteps before the recurrence,
+ * 	so that only the OUTPUT_DIM recurrent weight is left in the timestep loop
+ */
+#define RECURRENT_INPUT_PRECOMPUTE				1
+
+/*
+ * @note: configure the lookup table of SIGMOID_LUT, TANH_LUT and SOFTPLUS_LUT, ACTIVATION_LUT_SIZE segments
+ * 	over [-ACTIVATION_LUT_RANGE, ACTIVATION_LUT_RANGE], ACTIVATION_LUT_ORDER 0 for the nearest segment, 1 for the linear interpolation
+ * 	the tables are the ROM data of activation_lut.h, it is regenerated with activation_lut_generate when they change
+ */
+#define ACTIVATION_LUT_SIZE						256
+#define ACTIVATION_LUT_RANGE					8
+#define ACTIVATION_LUT_ORDER					1
+
+/*
+ * @note: configure the C simulation of the activation functions, 1 to calculate sigmoid, tanh and softplus of
+ * 	a whole layer output with the SSE/AVX2 kernels in activation_simd.h, 0 to call expf and logf per element,
+ * 	the kernels are only called by the host backend (HOST_BACKEND 1), so it has no effect on the synthesis
+ */
+#define ACTIVATION_SIMD							1
+
+/*
+ * @note: configure the C simulation of the layers, 1 to run the array and AXI based layers with the cache friendly
+ * 	host backend in host.h (im2col + GEMM for the convolutions, row major GEMV for Dense and the recurrent layers),
+ * 	0 to run the HLS loops, it has no effect on the synthesis
+ * 	CONVOLUTION2D_OPT_MODE and HOST_BACKEND can be defined before sdai.h, so a testbench can run the HLS loops of a given mode
+ */
+#ifndef HOST_BACKEND
+#define HOST_BACKEND							1
+#endif
+
+/*
+ * @note: configure the C simulation of a fixed point TYPE_T, 1 to emulate ap_fixed with the Fixed class in fixed.h
+ * 	which is bit accurate and runs on the native integers, 0 to simulate ap_fixed itself, it has no effect on the synthesis
+ * 	it is 0 until example/hls/testbench/fixed_lenet_tb.cpp and fixed_lstm_tb.cpp pass with the ap_fixed of the Vivado HLS in use,
+ * 	or of the open-source HLS_arbitrary_Precision_Types headers of Xilinx
+ */
+#define FIXED_EMULATION							0
+
+/*
+ * @note: configure the post-training calibration, 1 to record the range of the weights and the outputs of the layers
+ * 	and to round them to the recommended fixed point formats with calibration() in calibration.h,
+ * 	it is only used in C simulation and has no effect on the synthesis
+ */
+#define CALIBRATION								0
+
+/*
+ * @note: configure the FIFO channel between layers, 1 for the Xilinx hls::stream,
+ * 	0 for the plain C++ FIFO in stream.h which can only be used for C simulation,
+ * 	it can be defined before sdai.h, e.g. -DHLS_STREAM=0 with the ap_fixed headers that come without hls_stream.h
+ */
+#ifndef HLS_STREAM
+#define HLS_STREAM								1
+#endif
 
 /*
  * @note: the Debug switch
  */
 #define	DEBUG			0
 
+/*
+ * @note: the fixed point type ap_fixed<W, I, Q, O>, or its emulation in C simulation, see FIXED_EMULATION
+ */
+#if FIXED_EMULATION && !defined(__SYNTHESIS__)
+#define TYPE_FIXED(W, I, Q, O)		Fixed<W, I, Q, O>
+#else
+#define TYPE_FIXED(W, I, Q, O)		ap_fixed<W, I, Q, O>
+#endif
+
 /*
  * @note: user define data type
  */
 typedef			unsigned int				TYPE_PINT;
+typedef			signed char					TYPE_INT8;
+typedef			int							TYPE_INT32;
+typedef			unsigned int				TYPE_BWORD;
+typedef			signed char					TYPE_POW2;
 //typedef		double						TYPE_T;
 typedef			float						TYPE_T;
-//typedef		ap_fixed<15, 6, AP_TRN_ZERO>	TYPE_T;
-//typedef		ap_fixed<20, 12, AP_TRN_ZERO>	TYPE_T;
+//typedef		TYPE_FIXED(15, 6, AP_TRN_ZERO, AP_WRAP)		TYPE_T;
+//typedef		TYPE_FIXED(20, 12, AP_TRN_ZERO, AP_WRAP)	TYPE_T;
 
 
 }
@@ -5,6 +5,9 @@
 #ifndef __CONVOLUTION1D__
 #define __CONVOLUTION1D__
 #include "activation.h"
+#include "stream.h"
+#include "host.h"
+#include "calibration.h"
 #include <assert.h>
 #include "reshape.h"
 #include "mem.h"
@@ -21,12 +24,14 @@ namespace SDAI
  * @note: define the 1-dimension convolution layer
  * 			the input_shape = {STEP * INPUT_DIM}
  * 			the output_shape = {OUTPUT_DIM * INPUT_DIM}
+ * 			DATA_T is the type of the input and output, WEIGHT_T of the weight and bias, ACC_T of the sum of products
  * @params:
  * 		weight is a 3-D array(FILTER_LENGTH x INPUT_DIM x NB_FILTER) and then expand as 1-D array.
  * 		bias is a 1-D array, and its length is NB_FILTER
  * 		res is the layer output
  */
-template<int NB_FILTER, int FILTER_LENGTH, int STEP, int INPUT_DIM = 1, int SUBSAMPLE_LENGTH = 1, ACTIVATION AC_FN = LINEAR, int OUTPUT_DIM=((STEP - FILTER_LENGTH)/SUBSAMPLE_LENGTH + 1)>
+template<int NB_FILTER, int FILTER_LENGTH, int STEP, int INPUT_DIM = 1, int SUBSAMPLE_LENGTH = 1, ACTIVATION AC_FN = LINEAR, int OUTPUT_DIM=((STEP - FILTER_LENGTH)/SUBSAMPLE_LENGTH + 1),
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
 class Convolution1D
 {
 public:
@@ -59,20 +64,37 @@ public:
 		{
 			bias[k] = BIAS[k];
 		}
+#if CALIBRATION_HOST
+		calib = calibration().find("Convolution1D", WEIGHT);
+		calibration().weight(calib, &weight[0][0][0], FILTER_LENGTH * INPUT_DIM * NB_FILTER);
+		calibration().weight(calib, bias, NB_FILTER);
+#endif
 	}
 
 public:
-	TYPE_T	weight[FILTER_LENGTH][INPUT_DIM][NB_FILTER];
-	TYPE_T	bias[NB_FILTER];
-	TYPE_T	res[OUTPUT_DIM][NB_FILTER];
+	WEIGHT_T	weight[FILTER_LENGTH][INPUT_DIM][NB_FILTER];
+	WEIGHT_T	bias[NB_FILTER];
+	DATA_T		res[OUTPUT_DIM][NB_FILTER];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 	/*
 	 * @note: define the feedforward function
-	 * @params: data is a STEP * INPUT_DIM 2D array
+	 * @params: data is a STEP * INPUT_DIM 2D array, it is converted to DATA_T on read
 	 */
-	void feedforward(TYPE_T data[STEP][INPUT_DIM])
+	template<typename IN_T>
+	void feedforward(IN_T data[STEP][INPUT_DIM])
 	{
+#if HOST_NATIVE
+		host_convolution1D<DATA_T, ACC_T, NB_FILTER, FILTER_LENGTH, INPUT_DIM, SUBSAMPLE_LENGTH, AC_FN, OUTPUT_DIM>(&data[0][0], &weight[0][0][0], bias, &res[0][0]);
+#if CALIBRATION_HOST
+		calibration().data(calib, &res[0][0], OUTPUT_DIM * NB_FILTER);
+#endif
+		return;
+#endif
 		for( int i = 0; i < OUTPUT_DIM; i++)
 		{
 #if CONVOLUTION1D_PERF_MODE == PERF_HIGH
@@ -84,7 +106,7 @@ public:
 #pragma HLS pipeline
 #endif
 				/* calculate the weight and bias */
-				TYPE_T t = bias[j];
+				ACC_T t = bias[j];
 
 				for( int k = 0; k < FILTER_LENGTH; k++)
 				{
@@ -93,22 +115,70 @@ public:
 #if CONVOLUTION1D_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-						t += data[i*SUBSAMPLE_LENGTH + k][v] * weight[k][v][j];
+						t += (DATA_T)data[i*SUBSAMPLE_LENGTH + k][v] * weight[k][v][j];
 					}
 				}
 
 
 				/* calculate the activation function */
-				res[i][j] = activation_fn<AC_FN>(t);
+				res[i][j] = activation_fn<AC_FN, DATA_T>((DATA_T)t);
 			}
 		}
+#if CALIBRATION_HOST
+		calibration().data(calib, &res[0][0], OUTPUT_DIM * NB_FILTER);
+#endif
+	}
+
+	/*
+	 * @note: define the feedforward function with FIFO channels, the input is read step by step and each output step
+	 * 	is written as soon as its FILTER_LENGTH input steps are on chip
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		/* define a FILTER_LENGTH ring line buffer, a step is a line of 1 x INPUT_DIM */
+		LineBufferRing<FILTER_LENGTH, 1, INPUT_DIM, DATA_T>	line;
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+			/* read the steps of the window that are not in the line buffer yet */
+			line.advance(in, i * SUBSAMPLE_LENGTH, STEP);
+
+			for( int j = 0; j < NB_FILTER; j++)
+			{
+#if CONVOLUTION1D_PERF_MODE == PERF_MEDIAN || CONVOLUTION1D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				/* calculate the weight and bias */
+				ACC_T t = bias[j];
+
+				for( int k = 0; k < FILTER_LENGTH; k++)
+				{
+					for( int v  = 0; v < INPUT_DIM ; v++)
+					{
+#if CONVOLUTION1D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+						t += line.getval(k, 0, v) * weight[k][v][j];
+					}
+				}
+
+				/* calculate the activation function */
+				out.write(activation_fn<AC_FN, DATA_T>((DATA_T)t));
+			}
+		}
+
+		/* drop the steps after the last window */
+		line.drop(in, STEP);
 	}
 };
 
 /*
  * @note: define the data stream based convolution1D
+ * 			DATA_T is the type of the output and the on chip buffers, WEIGHT_T of the weight and bias, ACC_T of the sum of products
  */
-template<int NB_FILTER, int FILTER_LENGTH, int STEP, int INPUT_DIM = 1, int SUBSAMPLE_LENGTH = 1, ACTIVATION AC_FN = LINEAR, int OUTPUT_DIM=((STEP - FILTER_LENGTH)/SUBSAMPLE_LENGTH + 1)>
+template<int NB_FILTER, int FILTER_LENGTH, int STEP, int INPUT_DIM = 1, int SUBSAMPLE_LENGTH = 1, ACTIVATION AC_FN = LINEAR, int OUTPUT_DIM=((STEP - FILTER_LENGTH)/SUBSAMPLE_LENGTH + 1),
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
 class Convolution1D_DataStream
 {
 public:
@@ -141,29 +211,50 @@ public:
 		{
 			bias[k] = BIAS[k];
 		}
+#if CALIBRATION_HOST
+		calib = calibration().find("Convolution1D_DataStream", WEIGHT);
+		calibration().weight(calib, &weight[0][0][0], FILTER_LENGTH * INPUT_DIM * NB_FILTER);
+		calibration().weight(calib, bias, NB_FILTER);
+#endif
 	}
 
 public:
-	TYPE_T	weight[FILTER_LENGTH][INPUT_DIM][NB_FILTER];
-	TYPE_T	bias[NB_FILTER];
+	WEIGHT_T	weight[FILTER_LENGTH][INPUT_DIM][NB_FILTER];
+	WEIGHT_T	bias[NB_FILTER];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 	/*
 	 * @note: define the feedforward function
-	 * @params: data is a STEP * INPUT_DIM 2D array
+	 * @params: data is a STEP * INPUT_DIM 2D array, it is converted to DATA_T when it is read
 	 */
-	void feedforward(volatile TYPE_T *data, volatile TYPE_T *res)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res)
 	{
+#if HOST_NATIVE
+		host_convolution1D<DATA_T, ACC_T, NB_FILTER, FILTER_LENGTH, INPUT_DIM, SUBSAMPLE_LENGTH, AC_FN, OUTPUT_DIM>((const IN_T *)data, &weight[0][0][0], bias, (DATA_T *)res);
+#if CALIBRATION_HOST
+		calibration().data(calib, (DATA_T *)res, OUTPUT_DIM * NB_FILTER);
+#endif
+		return;
+#endif
 #if CONVOLUTION1D_OPT_MODE == OPT_BUFFER
 		/* define the line buffer and window buffer */
-		LineBuffer2D<FILTER_LENGTH, INPUT_DIM, SUBSAMPLE_LENGTH>				l_buffer;
+#if OPT_BUFFER_CIRCULAR
+		LineBuffer2D_Circular<FILTER_LENGTH, INPUT_DIM, SUBSAMPLE_LENGTH, DATA_T>	l_buffer;
+#else
+		LineBuffer2D<FILTER_LENGTH, INPUT_DIM, SUBSAMPLE_LENGTH, DATA_T>			l_buffer;
+#endif
 
 		/* fill the line buffer and window buffer */
 		l_buffer.fill( data );
 
 #elif CONVOLUTION1D_OPT_MODE == OPT_MEM
 		/* define a local BRAM*/
-		Reshape_Stream_2D<FILTER_LENGTH, INPUT_DIM>			stream;
+		Reshape_Stream_2D<FILTER_LENGTH, INPUT_DIM, ORDER_X, DATA_T>	stream;
 #endif
 		for( int i = 0; i < OUTPUT_DIM; i++)
 		{
@@ -175,7 +266,7 @@ public:
 			if( i > 0 && i < OUTPUT_DIM)
 			{
 				l_buffer.shift_up();
-				l_buffer.fill_line(&data[(i * SUBSAMPLE_LENGTH + FILTER_LENGTH - 1) * INPUT_DIM] );
+				l_buffer.fill_line(&data[(i * SUBSAMPLE_LENGTH + FILTER_LENGTH - SUBSAMPLE_LENGTH) * INPUT_DIM] );
 			}
 
 #elif CONVOLUTION1D_OPT_MODE == OPT_MEM
@@ -189,7 +280,7 @@ public:
 #pragma HLS pipeline
 #endif
 				/* calculate the weight and bias */
-				TYPE_T t = bias[j];
+				ACC_T t = bias[j];
 
 				for( int k = 0; k < FILTER_LENGTH; k++)
 				{
@@ -200,11 +291,11 @@ public:
 #endif
 
 #if CONVOLUTION1D_OPT_MODE == OPT_BUFFER
-						TYPE_T val = l_buffer.getval(k, v);
+						DATA_T val = l_buffer.getval(k, v);
 #elif CONVOLUTION1D_OPT_MODE == OPT_MEM
-						TYPE_T val = stream.res[k][v];
+						DATA_T val = stream.res[k][v];
 #else
-						TYPE_T val = data[(i * SUBSAMPLE_LENGTH + k) * INPUT_DIM + v ];
+						DATA_T val = (IN_T)data[(i * SUBSAMPLE_LENGTH + k) * INPUT_DIM + v ];
 #endif
 						t += val * weight[k][v][j];
 					}
@@ -212,9 +303,12 @@ public:
 
 
 				/* calculate the activation function */
-				res[i * NB_FILTER + j] = activation_fn<AC_FN>(t);
+				res[i * NB_FILTER + j] = activation_fn<AC_FN, DATA_T>((DATA_T)t);
 			}
 		}
+#if CALIBRATION_HOST
+		calibration().data(calib, (DATA_T *)res, OUTPUT_DIM * NB_FILTER);
+#endif
 	}
 };
 
@@ -6,6 +6,12 @@
 #define __CONVOLUTION2D_H__
 #include "activation.h"
 #include "configure.h"
+#include "stream.h"
+#include "host.h"
+#include "calibration.h"
+#include "quantize.h"
+#include "binary.h"
+#include "pow2.h"
 #include <assert.h>
 #include "mem.h"
 #include "reshape.h"
@@ -19,10 +25,12 @@ namespace SDAI
 
 /*
  * @note: define the convolution2D layer
+ * 	DATA_T is the type of the input and output, WEIGHT_T of the weight and bias, ACC_T of the sum of products
  */
 
 template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
-		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1 >
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
 class Convolution2D
 {
 public:
@@ -62,21 +70,39 @@ public:
 		{
 			bias[i] = BIAS[i];
 		}
+#if CALIBRATION_HOST
+		calib = calibration().find("Convolution2D", WEIGHT);
+		calibration().weight(calib, &weight[0][0][0][0], NB_ROW * NB_COL * INPUT_DIM * NB_FILTER);
+		calibration().weight(calib, bias, NB_FILTER);
+#endif
 	}
 public:
 	/*the weights is a 4D array with NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
-	TYPE_T	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER];
+	WEIGHT_T	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER];
 	/*the bias is a 1D array with NB_FILTER */
-	TYPE_T	bias[NB_FILTER];
-	TYPE_T res[OUT_ROW][OUT_COL][NB_FILTER];
+	WEIGHT_T	bias[NB_FILTER];
+	DATA_T res[OUT_ROW][OUT_COL][NB_FILTER];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 	/*
 	 * @note: the feedback function
-	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM
+	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM, it is converted to DATA_T on read
 	 */
-	void feedforward(TYPE_T data[ROW][COL][INPUT_DIM])
+	template<typename IN_T>
+	void feedforward(IN_T data[ROW][COL][INPUT_DIM])
 	{
+#if HOST_NATIVE
+		host_convolution2D<DATA_T, ACC_T, NB_FILTER, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, AC_FN, SUBSAMPLE_ROW, SUBSAMPLE_COL, OUT_ROW, OUT_COL>(
+				&data[0][0][0], &weight[0][0][0][0], bias, &res[0][0][0]);
+#if CALIBRATION_HOST
+		calibration().data(calib, &res[0][0][0], OUT_ROW * OUT_COL * NB_FILTER);
+#endif
+		return;
+#endif
 		for( int row = 0; row < OUT_ROW; row++)
 		{
 			for( int col = 0; col < OUT_COL; col++)
@@ -93,7 +119,7 @@ public:
 #pragma HLS pipeline
 #endif
 					/* calculate the weight and bias */
-					TYPE_T t = bias[k];
+					ACC_T t = bias[k];
 
 					for (int m = 0; m < NB_ROW; m++)
 					{
@@ -104,17 +130,75 @@ public:
 #if CONVOLUTION2D_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-								t += data[row * SUBSAMPLE_ROW + m][col * SUBSAMPLE_COL + n][v] * weight[m][n][v][k];
+								t += (DATA_T)data[row * SUBSAMPLE_ROW + m][col * SUBSAMPLE_COL + n][v] * weight[m][n][v][k];
 							}
 
 						}
 					}
 
 					/* calculate the activation function */
-					res[row][col][k] = activation_fn<AC_FN>(t);
+					res[row][col][k] = activation_fn<AC_FN, DATA_T>((DATA_T)t);
+				}
+			}
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, &res[0][0][0], OUT_ROW * OUT_COL * NB_FILTER);
+#endif
+	}
+
+	/*
+	 * @note: the feedback function with FIFO channels, the input is read row by row and each output row is written
+	 * 	as soon as its NB_ROW input rows are on chip, so the next layer can start before this one finishes
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		/* define a NB_ROW ring line buffer */
+		LineBufferRing<NB_ROW, COL, INPUT_DIM, DATA_T>	line;
+
+		for( int row = 0; row < OUT_ROW; row++)
+		{
+			/* read the rows of the window that are not in the line buffer yet */
+			line.advance(in, row * SUBSAMPLE_ROW, ROW);
+
+			for( int col = 0; col < OUT_COL; col++)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				for (int k = 0; k < NB_FILTER; k++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH || CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS LOOP_FLATTEN
+#endif
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+					/* calculate the weight and bias */
+					ACC_T t = bias[k];
+
+					for (int m = 0; m < NB_ROW; m++)
+					{
+						for (int n = 0; n < NB_COL; n++)
+						{
+							for (int v = 0; v < INPUT_DIM; v++)
+							{
+#if CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+								t += line.getval(m, col * SUBSAMPLE_COL + n, v) * weight[m][n][v][k];
+							}
+						}
+					}
+
+					/* calculate the activation function */
+					out.write(activation_fn<AC_FN, DATA_T>((DATA_T)t));
 				}
 			}
 		}
+
+		/* drop the rows below the last window */
+		line.drop(in, ROW);
 	}
 };
 
@@ -122,10 +206,12 @@ public:
 
 /*
  * @note: define the Convolution2D_DataStream layer
+ * 	DATA_T is the type of the output and the on chip buffers, WEIGHT_T of the weight and bias, ACC_T of the sum of products
  */
 
 template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
-		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1 >
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
 class Convolution2D_DataStream
 {
 public:
@@ -166,27 +252,50 @@ public:
 		{
 			bias[i] = BIAS[i];
 		}
+#if CALIBRATION_HOST
+		calib = calibration().find("Convolution2D_DataStream", WEIGHT);
+		calibration().weight(calib, &weight[0][0][0][0], NB_ROW * NB_COL * INPUT_DIM * NB_FILTER);
+		calibration().weight(calib, bias, NB_FILTER);
+#endif
 	}
 public:
 	/*the weights is a 4D array with NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
-	TYPE_T	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER];
+	WEIGHT_T	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER];
 	/*the bias is a 1D array with NB_FILTER */
-	TYPE_T	bias[NB_FILTER];
+	WEIGHT_T	bias[NB_FILTER];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 
 
 	/*
 	 * @note: the feedback function
-	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM
+	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM, it is converted to DATA_T when it is read
 	 */
-	void feedforward(volatile TYPE_T *data, volatile TYPE_T *res)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res)
 	{
+#if HOST_NATIVE
+		host_convolution2D<DATA_T, ACC_T, NB_FILTER, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, AC_FN, SUBSAMPLE_ROW, SUBSAMPLE_COL, OUT_ROW, OUT_COL>(
+				(const IN_T *)data, &weight[0][0][0][0], bias, (DATA_T *)res);
+#if CALIBRATION_HOST
+		calibration().data(calib, (DATA_T *)res, OUT_ROW * OUT_COL * NB_FILTER);
+#endif
+		return;
+#endif
 
 #if CONVOLUTION2D_OPT_MODE == OPT_BUFFER
 		/* define a 3D LineBuffer */
-		LineBuffer3D<NB_ROW, COL, INPUT_DIM, SUBSAMPLE_ROW>									l_buffer;
-		WindowBuffer3D<NB_ROW, NB_COL, INPUT_DIM, COL, SUBSAMPLE_ROW, SUBSAMPLE_COL>		w_buffer;
+#if OPT_BUFFER_CIRCULAR
+		LineBuffer3D_Circular<NB_ROW, COL, INPUT_DIM, SUBSAMPLE_ROW, DATA_T>						l_buffer;
+		WindowBuffer3D_Circular<NB_ROW, NB_COL, INPUT_DIM, COL, SUBSAMPLE_ROW, SUBSAMPLE_COL, DATA_T>		w_buffer;
+#else
+		LineBuffer3D<NB_ROW, COL, INPUT_DIM, SUBSAMPLE_ROW, DATA_T>								l_buffer;
+		WindowBuffer3D<NB_ROW, NB_COL, INPUT_DIM, COL, SUBSAMPLE_ROW, SUBSAMPLE_COL, DATA_T>		w_buffer;
+#endif
 
 		/* fill the line buffer and window buffer */
 		l_buffer.fill( data );
@@ -194,19 +303,28 @@ public:
 
 #elif CONVOLUTION2D_OPT_MODE == OPT_MEM
 		/* define a local BRAM to store part of the data */
-		Reshape_Stream_3D<NB_ROW, COL, INPUT_DIM>											stream;
+		Reshape_Stream_3D<NB_ROW, COL, INPUT_DIM, ORDER_X, DATA_T>							stream;
 #pragma HLS ARRAY_PARTITION variable=stream.res dim=1 complete
 
+#elif CONVOLUTION2D_OPT_MODE == OPT_STREAM
+		/* define a NB_ROW ring line buffer, each input element is read once from the AXI master */
+		LineBufferRing<NB_ROW, COL, INPUT_DIM, DATA_T>	line;
+
 #endif
 
 		for( int row = 0; row < OUT_ROW; row++)
 		{
+#if CONVOLUTION2D_OPT_MODE == OPT_STREAM
+			/* read the rows of the window that are not in the line buffer yet */
+			line.advance(data, row * SUBSAMPLE_ROW, ROW);
+#endif
+
 #if CONVOLUTION2D_OPT_MODE == OPT_BUFFER
 			/* update the 3D LineBuffer*/
 			if( row > 0 && row < OUT_ROW)
 			{
 				l_buffer.shift_up();
-				l_buffer.fill_line( &data[((row + NB_ROW - 1) * SUBSAMPLE_ROW ) * COL * INPUT_DIM] );
+				l_buffer.fill_line( &data[(row * SUBSAMPLE_ROW + NB_ROW - SUBSAMPLE_ROW) * COL * INPUT_DIM] );
 				w_buffer.fill( l_buffer, 0 );
 			}
 
@@ -228,7 +346,7 @@ public:
 				if( col > 0 && col < OUT_COL)
 				{
 					w_buffer.shift_left();
-					w_buffer.insert_right(l_buffer, (col + NB_COL - 1) * SUBSAMPLE_COL);
+					w_buffer.insert_right(l_buffer, col * SUBSAMPLE_COL + NB_COL - SUBSAMPLE_COL);
 				}
 #endif
 
@@ -241,7 +359,7 @@ public:
 #pragma HLS pipeline
 #endif
 					/* calculate the weight and bias */
-					TYPE_T t = bias[k];
+					ACC_T t = bias[k];
 
 					for (int m = 0; m < NB_ROW; m++)
 					{
@@ -254,11 +372,13 @@ public:
 #endif
 
 #if CONVOLUTION2D_OPT_MODE == OPT_BUFFER
-								TYPE_T val = w_buffer.getval(m, n, v);
+								DATA_T val = w_buffer.getval(m, n, v);
 #elif CONVOLUTION2D_OPT_MODE == OPT_MEM
-								TYPE_T val = stream.res[m][col * SUBSAMPLE_COL + n][v];
+								DATA_T val = stream.res[m][col * SUBSAMPLE_COL + n][v];
+#elif CONVOLUTION2D_OPT_MODE == OPT_STREAM
+								DATA_T val = line.getval(m, col * SUBSAMPLE_COL + n, v);
 #else
-								TYPE_T val = data[(row * SUBSAMPLE_ROW + m) * COL * INPUT_DIM + (col * SUBSAMPLE_COL + n) * INPUT_DIM + v];
+								DATA_T val = (IN_T)data[(row * SUBSAMPLE_ROW + m) * COL * INPUT_DIM + (col * SUBSAMPLE_COL + n) * INPUT_DIM + v];
 #endif
 								t += val * weight[m][n][v][k];
 							}
@@ -267,7 +387,1000 @@ public:
 					}
 
 					/* calculate the activation function */
-					res[row * OUT_COL * NB_FILTER + col * NB_FILTER + k] = activation_fn<AC_FN>(t);
+					res[row * OUT_COL * NB_FILTER + col * NB_FILTER + k] = activation_fn<AC_FN, DATA_T>((DATA_T)t);
+				}
+			}
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, (DATA_T *)res, OUT_ROW * OUT_COL * NB_FILTER);
+#endif
+	}
+};
+
+/*
+ * @note: define the int8 convolution2D layer, the weight is int8 with a scale per filter, the sum of products is int32
+ * 	and it is requantized to the int8 output with a fixed point multiplier and shift, see quantize.h
+ * 	IN_SCALE and OUT_SCALE are the real values of one step of the int8 input and output, AC_FN can only be LINEAR or RELU
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1 >
+class Convolution2D_Int8
+{
+public:
+	Convolution2D_Int8(const TYPE_T *WEIGHT, const TYPE_T *BIAS, float IN_SCALE, float OUT_SCALE)
+	{
+		assert(ROW > NB_ROW);
+		assert(COL > NB_COL);
+		assert(AC_FN == LINEAR || AC_FN == RELU);
+#pragma HLS ARRAY_PARTITION variable=weight dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=weight dim=2 complete
+#if DEBUG
+		cout<<"Convolution2D_Int8 Layer......"<<endl;
+		cout<<"\tNB_FILTER = " << NB_FILTER << endl;
+		cout<<"\tNB_ROW = " << NB_ROW << endl;
+		cout<<"\tNB_COL = " << NB_COL << endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tINPUT_DIM = "<<INPUT_DIM << endl;
+		cout<<"\tSUBSAMPLE_ROW = " << SUBSAMPLE_ROW << endl;
+		cout<<"\tSUBSAMPLE_COL = " << SUBSAMPLE_COL << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+		cout<<"\tIN_SCALE = " << IN_SCALE << endl;
+		cout<<"\tOUT_SCALE = " << OUT_SCALE << endl;
+#endif
+
+		/* initialize the weight and bias, the layout of WEIGHT is NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
+		quantize_weight_int8<NB_ROW * NB_COL * INPUT_DIM, NB_FILTER>(WEIGHT, BIAS, IN_SCALE, OUT_SCALE,
+				&weight[0][0][0][0], bias, mult, shift);
+	}
+public:
+	/*the weights is a 4D array with NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
+	TYPE_INT8	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER];
+	/*the bias is a 1D array with NB_FILTER */
+	TYPE_INT32	bias[NB_FILTER];
+	/* the requantization of each filter */
+	TYPE_INT32	mult[NB_FILTER];
+	int			shift[NB_FILTER];
+	TYPE_INT8	res[OUT_ROW][OUT_COL][NB_FILTER];
+
+public:
+	/*
+	 * @note: the feedback function
+	 * @params: the input data is a 3D int8 array, ROW * COL * INPUT_DIM
+	 */
+	void feedforward(TYPE_INT8 data[ROW][COL][INPUT_DIM])
+	{
+		for( int row = 0; row < OUT_ROW; row++)
+		{
+			for( int col = 0; col < OUT_COL; col++)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				for (int k = 0; k < NB_FILTER; k++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH || CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS LOOP_FLATTEN
+#endif
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+					/* calculate the weight and bias */
+					TYPE_INT32 t = bias[k];
+
+					for (int m = 0; m < NB_ROW; m++)
+					{
+						for (int n = 0; n < NB_COL; n++)
+						{
+							for (int v = 0; v < INPUT_DIM; v++)
+							{
+#if CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+								t += data[row * SUBSAMPLE_ROW + m][col * SUBSAMPLE_COL + n][v] * weight[m][n][v][k];
+							}
+						}
+					}
+
+					/* requantize and calculate the activation function */
+					res[row][col][k] = requantize<AC_FN>(t, mult[k], shift[k]);
+				}
+			}
+		}
+	}
+};
+
+/*
+ * @note: define the int8 Convolution2D_DataStream layer, the input and output are int8 arrays on the AXI master,
+ * 	the input rows are kept in a NB_ROW line buffer as in OPT_STREAM of Convolution2D_DataStream, so each input is read once
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1 >
+class Convolution2D_DataStream_Int8
+{
+public:
+	Convolution2D_DataStream_Int8(const TYPE_T *WEIGHT, const TYPE_T *BIAS, float IN_SCALE, float OUT_SCALE)
+	{
+		assert(ROW > NB_ROW);
+		assert(COL > NB_COL);
+		assert(AC_FN == LINEAR || AC_FN == RELU);
+#pragma HLS ARRAY_PARTITION variable=weight dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=weight dim=2 complete
+#if DEBUG
+		cout<<"Convolution2D_DataStream_Int8 Layer......"<<endl;
+		cout<<"\tNB_FILTER = " << NB_FILTER << endl;
+		cout<<"\tNB_ROW = " << NB_ROW << endl;
+		cout<<"\tNB_COL = " << NB_COL << endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tINPUT_DIM = "<<INPUT_DIM << endl;
+		cout<<"\tSUBSAMPLE_ROW = " << SUBSAMPLE_ROW << endl;
+		cout<<"\tSUBSAMPLE_COL = " << SUBSAMPLE_COL << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+		cout<<"\tIN_SCALE = " << IN_SCALE << endl;
+		cout<<"\tOUT_SCALE = " << OUT_SCALE << endl;
+#endif
+
+		/* initialize the weight and bias, the layout of WEIGHT is NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
+		quantize_weight_int8<NB_ROW * NB_COL * INPUT_DIM, NB_FILTER>(WEIGHT, BIAS, IN_SCALE, OUT_SCALE,
+				&weight[0][0][0][0], bias, mult, shift);
+	}
+public:
+	/*the weights is a 4D array with NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
+	TYPE_INT8	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER];
+	/*the bias is a 1D array with NB_FILTER */
+	TYPE_INT32	bias[NB_FILTER];
+	/* the requantization of each filter */
+	TYPE_INT32	mult[NB_FILTER];
+	int			shift[NB_FILTER];
+
+public:
+	/*
+	 * @note: the feedback function
+	 * @params: the input data is a 3D int8 array, ROW * COL * INPUT_DIM
+	 */
+	void feedforward(volatile TYPE_INT8 *data, volatile TYPE_INT8 *res)
+	{
+		/* define a NB_ROW ring line buffer, each input element is read once from the AXI master */
+		LineBufferRing<NB_ROW, COL, INPUT_DIM, TYPE_INT8>	line;
+
+		for( int row = 0; row < OUT_ROW; row++)
+		{
+			/* read the rows of the window that are not in the line buffer yet */
+			line.advance(data, row * SUBSAMPLE_ROW, ROW);
+
+			/* process the 2D convolution */
+			for( int col = 0; col < OUT_COL; col++)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				for (int k = 0; k < NB_FILTER; k++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH || CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS LOOP_FLATTEN
+#endif
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+					/* calculate the weight and bias */
+					TYPE_INT32 t = bias[k];
+
+					for (int m = 0; m < NB_ROW; m++)
+					{
+						for (int n = 0; n < NB_COL; n++)
+						{
+							for (int v = 0; v < INPUT_DIM; v++)
+							{
+#if CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+								t += line.getval(m, col * SUBSAMPLE_COL + n, v) * weight[m][n][v][k];
+							}
+						}
+					}
+
+					/* requantize and calculate the activation function */
+					res[row * OUT_COL * NB_FILTER + col * NB_FILTER + k] = requantize<AC_FN>(t, mult[k], shift[k]);
+				}
+			}
+		}
+	}
+};
+
+/*
+ * @note: define the binarized convolution2D layer, the weight and the input are +1 or -1 and the channels of a pixel are packed
+ * 	into BINARY_NB_WORD(INPUT_DIM) words, see binary.h
+ * 	the dot product is an XNOR and a popcount and the activation is the threshold of the folded bias and batch normalization,
+ * 	the output channels are packed in the same way, so the binary layers can be chained
+ * 	the weight and bias are the float WEIGHT and BIAS of Convolution2D, only the sign of the weight is kept
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1 >
+class Convolution2D_Binary
+{
+public:
+	Convolution2D_Binary(const TYPE_T *WEIGHT, const TYPE_T *BIAS, const TYPE_T *BATCHNORM = 0)
+	{
+		assert(ROW > NB_ROW);
+		assert(COL > NB_COL);
+#pragma HLS ARRAY_PARTITION variable=weight dim=1 complete
+#if DEBUG
+		cout<<"Convolution2D_Binary Layer......"<<endl;
+		cout<<"\tNB_FILTER = " << NB_FILTER << endl;
+		cout<<"\tNB_ROW = " << NB_ROW << endl;
+		cout<<"\tNB_COL = " << NB_COL << endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tINPUT_DIM = "<<INPUT_DIM << endl;
+		cout<<"\tSUBSAMPLE_ROW = " << SUBSAMPLE_ROW << endl;
+		cout<<"\tSUBSAMPLE_COL = " << SUBSAMPLE_COL << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+#endif
+
+		/* initialize the weight and threshold, the layout of WEIGHT is NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
+		binary_pack_weight<NB_ROW * NB_COL * INPUT_DIM, NB_FILTER, INPUT_DIM>(WEIGHT, &weight[0][0][0][0]);
+		binary_threshold<NB_ROW * NB_COL * INPUT_DIM, NB_FILTER>(BIAS, BATCHNORM, threshold, positive);
+	}
+public:
+	/*the weights is a 4D array with NB_FILTER * NB_ROW * NB_COL * BINARY_NB_WORD(INPUT_DIM) */
+	TYPE_BWORD	weight[NB_FILTER][NB_ROW][NB_COL][BINARY_NB_WORD(INPUT_DIM)];
+	TYPE_INT32	threshold[NB_FILTER];
+	bool		positive[NB_FILTER];
+	TYPE_BWORD	res[OUT_ROW][OUT_COL][BINARY_NB_WORD(NB_FILTER)];
+
+public:
+	/*
+	 * @note: the feedback function
+	 * @params: the input data is a packed 3D array, ROW * COL * BINARY_NB_WORD(INPUT_DIM)
+	 */
+	void feedforward(TYPE_BWORD data[ROW][COL][BINARY_NB_WORD(INPUT_DIM)])
+	{
+		for( int row = 0; row < OUT_ROW; row++)
+		{
+			for( int col = 0; col < OUT_COL; col++)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				for( int w = 0; w < BINARY_NB_WORD(NB_FILTER); w++)
+					res[row][col][w] = 0;
+
+				for (int k = 0; k < NB_FILTER; k++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH || CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS LOOP_FLATTEN
+#endif
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+					/* count the different signs in the window */
+					int diff = 0;
+
+					for (int m = 0; m < NB_ROW; m++)
+					{
+						for (int n = 0; n < NB_COL; n++)
+						{
+							for (int v = 0; v < BINARY_NB_WORD(INPUT_DIM); v++)
+							{
+#if CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+								diff += binary_popcount(data[row * SUBSAMPLE_ROW + m][col * SUBSAMPLE_COL + n][v] ^ weight[k][m][n][v]);
+							}
+						}
+					}
+
+					/* calculate the threshold activation */
+					TYPE_INT32 dot = NB_ROW * NB_COL * INPUT_DIM - 2 * diff;
+					if( binary_activation(dot, threshold[k], positive[k]) )
+						res[row][col][k / BINARY_WORD_BITS] |= (TYPE_BWORD)1 << (k % BINARY_WORD_BITS);
+				}
+			}
+		}
+	}
+};
+
+/*
+ * @note: define the convolution2D layer with power of two weights, each weight is NB_TERM terms +-2^e, see pow2.h,
+ * 	so a product of the data and a weight is NB_TERM shifts and additions in ACC_T instead of a multiplier
+ * 	the weight is converted from the float WEIGHT of Convolution2D, the bias is kept in ACC_T
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int NB_TERM = 1, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1,
+		typename DATA_T = TYPE_T, typename ACC_T = TYPE_T>
+class Convolution2D_Pow2
+{
+public:
+	Convolution2D_Pow2(const TYPE_T *WEIGHT, const TYPE_T *BIAS)
+	{
+		assert(ROW > NB_ROW);
+		assert(COL > NB_COL);
+		assert(NB_TERM > 0);
+#pragma HLS ARRAY_PARTITION variable=weight dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=weight dim=2 complete
+#if DEBUG
+		cout<<"Convolution2D_Pow2 Layer......"<<endl;
+		cout<<"\tNB_FILTER = " << NB_FILTER << endl;
+		cout<<"\tNB_ROW = " << NB_ROW << endl;
+		cout<<"\tNB_COL = " << NB_COL << endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tINPUT_DIM = "<<INPUT_DIM << endl;
+		cout<<"\tSUBSAMPLE_ROW = " << SUBSAMPLE_ROW << endl;
+		cout<<"\tSUBSAMPLE_COL = " << SUBSAMPLE_COL << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+		cout<<"\tNB_TERM = " << NB_TERM << endl;
+#endif
+
+		/* initialize the weight and bias, the layout of WEIGHT is NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
+		pow2_convert<NB_TERM>(WEIGHT, NB_ROW * NB_COL * INPUT_DIM * NB_FILTER, &weight[0][0][0][0][0]);
+		for( int i = 0; i < NB_FILTER; i++)
+		{
+			bias[i] = BIAS[i];
+		}
+	}
+public:
+	/*the weights is a 5D array with NB_ROW * NB_COL * INPUT_DIM * NB_FILTER * NB_TERM */
+	TYPE_POW2	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER][NB_TERM];
+	/*the bias is a 1D array with NB_FILTER */
+	ACC_T		bias[NB_FILTER];
+	DATA_T res[OUT_ROW][OUT_COL][NB_FILTER];
+
+public:
+	/*
+	 * @note: the feedback function
+	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM, it is converted to DATA_T on read
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[ROW][COL][INPUT_DIM])
+	{
+		for( int row = 0; row < OUT_ROW; row++)
+		{
+			for( int col = 0; col < OUT_COL; col++)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				for (int k = 0; k < NB_FILTER; k++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH || CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS LOOP_FLATTEN
+#endif
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+					/* calculate the weight and bias */
+					ACC_T t = bias[k];
+
+					for (int m = 0; m < NB_ROW; m++)
+					{
+						for (int n = 0; n < NB_COL; n++)
+						{
+							for (int v = 0; v < INPUT_DIM; v++)
+							{
+#if CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+								DATA_T val = data[row * SUBSAMPLE_ROW + m][col * SUBSAMPLE_COL + n][v];
+								for( int s = 0; s < NB_TERM; s++)
+									pow2_mac(t, val, weight[m][n][v][k][s]);
+							}
+						}
+					}
+
+					/* calculate the activation function */
+					res[row][col][k] = activation_fn<AC_FN, DATA_T>((DATA_T)t);
+				}
+			}
+		}
+	}
+};
+
+/*
+ * @note: the transforms of the Winograd minimal filtering F(2x2, 3x3), the output is Y = A^T[(G g G^T) .* (B^T d B)]A
+ */
+/*
+ * @note: transform a 3x3 filter g into the 4x4 filter u = G g G^T
+ */
+template<typename T>
+inline void winograd_filter_transform(T g[3][3], T u[4][4])
+{
+#pragma HLS INLINE
+	T t[4][3];
+	for( int j = 0; j < 3; j++)
+	{
+		t[0][j] = g[0][j];
+		t[1][j] = (g[0][j] + g[1][j] + g[2][j]) * (T)0.5;
+		t[2][j] = (g[0][j] - g[1][j] + g[2][j]) * (T)0.5;
+		t[3][j] = g[2][j];
+	}
+	for( int i = 0; i < 4; i++)
+	{
+		u[i][0] = t[i][0];
+		u[i][1] = (t[i][0] + t[i][1] + t[i][2]) * (T)0.5;
+		u[i][2] = (t[i][0] - t[i][1] + t[i][2]) * (T)0.5;
+		u[i][3] = t[i][2];
+	}
+}
+
+/*
+ * @note: transform a 4x4 input tile d into v = B^T d B, only additions are needed
+ */
+template<typename T>
+inline void winograd_input_transform(T d[4][4], T v[4][4])
+{
+#pragma HLS INLINE
+	T t[4][4];
+	for( int j = 0; j < 4; j++)
+	{
+		t[0][j] = d[0][j] - d[2][j];
+		t[1][j] = d[1][j] + d[2][j];
+		t[2][j] = d[2][j] - d[1][j];
+		t[3][j] = d[1][j] - d[3][j];
+	}
+	for( int i = 0; i < 4; i++)
+	{
+		v[i][0] = t[i][0] - t[i][2];
+		v[i][1] = t[i][1] + t[i][2];
+		v[i][2] = t[i][2] - t[i][1];
+		v[i][3] = t[i][1] - t[i][3];
+	}
+}
+
+/*
+ * @note: transform a 4x4 product tile m into the 2x2 output y = A^T m A, only additions are needed
+ */
+template<typename T>
+inline void winograd_output_transform(T m[4][4], T y[2][2])
+{
+#pragma HLS INLINE
+	T t[2][4];
+	for( int j = 0; j < 4; j++)
+	{
+		t[0][j] = m[0][j] + m[1][j] + m[2][j];
+		t[1][j] = m[1][j] - m[2][j] - m[3][j];
+	}
+	for( int i = 0; i < 2; i++)
+	{
+		y[i][0] = t[i][0] + t[i][1] + t[i][2];
+		y[i][1] = t[i][1] - t[i][2] - t[i][3];
+	}
+}
+
+/*
+ * @note: transform the 3x3 weight of Convolution2D layout, NB_ROW * NB_COL * INPUT_DIM * NB_FILTER,
+ * 	into the 4x4 weight of the Winograd layers, the transform is calculated in TYPE_T and rounded to WEIGHT_T once
+ */
+template<int INPUT_DIM, int NB_FILTER, typename WEIGHT_T>
+inline void winograd_weight_transform(const TYPE_T *WEIGHT, WEIGHT_T weight[4][4][INPUT_DIM][NB_FILTER])
+{
+	for( int m = 0; m < INPUT_DIM; m++)
+	{
+		for(int n = 0; n < NB_FILTER; n++)
+		{
+			TYPE_T g[3][3], u[4][4];
+			for( int i = 0; i < 3; i++)
+			{
+				for( int j = 0; j < 3; j++)
+					g[i][j] = WEIGHT[ i*3*INPUT_DIM*NB_FILTER + j*INPUT_DIM*NB_FILTER + m*NB_FILTER + n];
+			}
+			winograd_filter_transform(g, u);
+			for( int i = 0; i < 4; i++)
+			{
+				for( int j = 0; j < 4; j++)
+					weight[i][j][m][n] = u[i][j];
+			}
+		}
+	}
+}
+
+/*
+ * @note: calculate the 2x2 output tile y of every filter from the 4x4 input tile d of every input channel,
+ * 	the input tile is transformed, multiplied with the transformed weight element-wise and accumulated over
+ * 	the input channels, then transformed back, added with the bias and passed through the activation function
+ * 	the transforms and the sum of products are calculated in ACC_T, the input and output tiles are DATA_T
+ */
+template<int INPUT_DIM, int NB_FILTER, ACTIVATION AC_FN, typename DATA_T, typename WEIGHT_T, typename ACC_T>
+inline void winograd_tile(DATA_T d[4][4][INPUT_DIM], WEIGHT_T weight[4][4][INPUT_DIM][NB_FILTER], WEIGHT_T bias[NB_FILTER],
+		DATA_T y[2][2][NB_FILTER])
+{
+#pragma HLS INLINE
+	/* transform the input tile of every input channel */
+	ACC_T v[4][4][INPUT_DIM];
+#pragma HLS ARRAY_PARTITION variable=v dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=v dim=2 complete
+	for( int c = 0; c < INPUT_DIM; c++)
+	{
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN || CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+		ACC_T dc[4][4], t[4][4];
+		for( int i = 0; i < 4; i++)
+		{
+			for( int j = 0; j < 4; j++)
+				dc[i][j] = d[i][j][c];
+		}
+		winograd_input_transform(dc, t);
+		for( int i = 0; i < 4; i++)
+		{
+			for( int j = 0; j < 4; j++)
+				v[i][j][c] = t[i][j];
+		}
+	}
+
+	for (int k = 0; k < NB_FILTER; k++)
+	{
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+		/* the element-wise product in the Winograd domain */
+		ACC_T m[4][4], o[2][2];
+		for( int i = 0; i < 4; i++)
+		{
+			for( int j = 0; j < 4; j++)
+				m[i][j] = 0;
+		}
+		for( int c = 0; c < INPUT_DIM; c++)
+		{
+#if CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+			for( int i = 0; i < 4; i++)
+			{
+				for( int j = 0; j < 4; j++)
+					m[i][j] += v[i][j][c] * weight[i][j][c][k];
+			}
+		}
+		winograd_output_transform(m, o);
+
+		/* add the bias and calculate the activation function */
+		for( int i = 0; i < 2; i++)
+		{
+			for( int j = 0; j < 2; j++)
+			{
+				ACC_T t = o[i][j] + bias[k];
+				y[i][j][k] = activation_fn<AC_FN, DATA_T>((DATA_T)t);
+			}
+		}
+	}
+}
+
+/*
+ * @note: define the Winograd F(2x2, 3x3) convolution2D layer, it only supports 3x3 kernels with 1x1 subsample,
+ * 	the weight layout is the same as Convolution2D, and 16 instead of 36 multiplications are used for each 2x2 output tile
+ * 	DATA_T is the type of the input and output, WEIGHT_T of the transformed weight and bias, ACC_T of the transforms and the sum of products
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class Convolution2D_Winograd
+{
+public:
+	Convolution2D_Winograd(const TYPE_T *WEIGHT, const TYPE_T *BIAS)
+	{
+		assert(NB_ROW == 3);
+		assert(NB_COL == 3);
+		assert(SUBSAMPLE_ROW == 1);
+		assert(SUBSAMPLE_COL == 1);
+		assert(ROW > NB_ROW);
+		assert(COL > NB_COL);
+#pragma HLS ARRAY_PARTITION variable=weight dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=weight dim=2 complete
+#if DEBUG
+		cout<<"Convolution2D_Winograd Layer......"<<endl;
+		cout<<"\tNB_FILTER = " << NB_FILTER << endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tINPUT_DIM = "<<INPUT_DIM << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+#endif
+
+		/* transform the weight once, and initialize the bias */
+		winograd_weight_transform<INPUT_DIM, NB_FILTER>(WEIGHT, weight);
+		for( int i = 0; i < NB_FILTER; i++)
+		{
+			bias[i] = BIAS[i];
+		}
+	}
+public:
+	/*the transformed weights is a 4D array with 4 * 4 * INPUT_DIM * NB_FILTER */
+	WEIGHT_T	weight[4][4][INPUT_DIM][NB_FILTER];
+	/*the bias is a 1D array with NB_FILTER */
+	WEIGHT_T	bias[NB_FILTER];
+	DATA_T	res[OUT_ROW][OUT_COL][NB_FILTER];
+
+public:
+	/*
+	 * @note: the feedback function
+	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM, it is converted to DATA_T on read
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[ROW][COL][INPUT_DIM])
+	{
+		for( int row = 0; row < OUT_ROW; row += 2)
+		{
+			for( int col = 0; col < OUT_COL; col += 2)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				/* read the input tile of every input channel, the tile is padded with zero at the border */
+				DATA_T d[4][4][INPUT_DIM], y[2][2][NB_FILTER];
+#pragma HLS ARRAY_PARTITION variable=d dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=d dim=2 complete
+#pragma HLS ARRAY_PARTITION variable=y dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=y dim=2 complete
+				for( int c = 0; c < INPUT_DIM; c++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN || CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+					for( int i = 0; i < 4; i++)
+					{
+						for( int j = 0; j < 4; j++)
+							d[i][j][c] = (row + i < ROW && col + j < COL) ? (DATA_T)data[row + i][col + j][c] : (DATA_T)0;
+					}
+				}
+				winograd_tile<INPUT_DIM, NB_FILTER, AC_FN, DATA_T, WEIGHT_T, ACC_T>(d, weight, bias, y);
+
+				for( int i = 0; i < 2; i++)
+				{
+					for( int j = 0; j < 2; j++)
+					{
+						if( row + i < OUT_ROW && col + j < OUT_COL)
+						{
+							for( int k = 0; k < NB_FILTER; k++)
+								res[row + i][col + j][k] = y[i][j][k];
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedback function with FIFO channels, the input is read row by row and
+	 * 	every two output rows are written as soon as their 4 input rows are on chip
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		/* define a 4-row ring line buffer */
+		LineBufferRing<4, COL, INPUT_DIM, DATA_T>	line;
+
+		/* the two output rows of the current tile row */
+		DATA_T	tile_res[2][OUT_COL][NB_FILTER];
+#pragma HLS ARRAY_PARTITION variable=tile_res dim=1 complete
+
+		for( int row = 0; row < OUT_ROW; row += 2)
+		{
+			/* read the rows of the tile row that are not in the line buffer yet */
+			line.advance(in, row, ROW);
+
+			for( int col = 0; col < OUT_COL; col += 2)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				/* read the input tile of every input channel, the tile is padded with zero at the border */
+				DATA_T d[4][4][INPUT_DIM], y[2][2][NB_FILTER];
+#pragma HLS ARRAY_PARTITION variable=d dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=d dim=2 complete
+#pragma HLS ARRAY_PARTITION variable=y dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=y dim=2 complete
+				for( int c = 0; c < INPUT_DIM; c++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN || CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+					for( int i = 0; i < 4; i++)
+					{
+						for( int j = 0; j < 4; j++)
+							d[i][j][c] = (row + i < ROW && col + j < COL) ? line.getval(i, col + j, c) : (DATA_T)0;
+					}
+				}
+				winograd_tile<INPUT_DIM, NB_FILTER, AC_FN, DATA_T, WEIGHT_T, ACC_T>(d, weight, bias, y);
+
+				for( int i = 0; i < 2; i++)
+				{
+					for( int j = 0; j < 2; j++)
+					{
+						if( col + j < OUT_COL)
+						{
+							for( int k = 0; k < NB_FILTER; k++)
+								tile_res[i][col + j][k] = y[i][j][k];
+						}
+					}
+				}
+			}
+
+			/* write the output rows in order */
+			for( int i = 0; i < 2; i++)
+			{
+				if( row + i < OUT_ROW )
+				{
+					for( int col = 0; col < OUT_COL; col++)
+					{
+						for( int k = 0; k < NB_FILTER; k++)
+						{
+#pragma HLS pipeline
+							out.write(tile_res[i][col][k]);
+						}
+					}
+				}
+			}
+		}
+	}
+};
+
+
+/*
+ * @note: define the Winograd F(2x2, 3x3) Convolution2D_DataStream layer,
+ * 	a 4-row line buffer is kept on chip and each input element is read from the AXI master once
+ * 	DATA_T is the type of the output and the line buffer, WEIGHT_T of the transformed weight and bias, ACC_T of the transforms and the sum of products
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
+		int OUT_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int OUT_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class Convolution2D_Winograd_DataStream
+{
+public:
+	Convolution2D_Winograd_DataStream(const TYPE_T *WEIGHT, const TYPE_T *BIAS)
+	{
+		assert(NB_ROW == 3);
+		assert(NB_COL == 3);
+		assert(SUBSAMPLE_ROW == 1);
+		assert(SUBSAMPLE_COL == 1);
+		assert(ROW > NB_ROW);
+		assert(COL > NB_COL);
+#pragma HLS ARRAY_PARTITION variable=weight dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=weight dim=2 complete
+#if DEBUG
+		cout<<"Convolution2D_Winograd_DataStream Layer......"<<endl;
+		cout<<"\tNB_FILTER = " << NB_FILTER << endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tINPUT_DIM = "<<INPUT_DIM << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+#endif
+
+		/* transform the weight once, and initialize the bias */
+		winograd_weight_transform<INPUT_DIM, NB_FILTER>(WEIGHT, weight);
+		for( int i = 0; i < NB_FILTER; i++)
+		{
+			bias[i] = BIAS[i];
+		}
+	}
+public:
+	/*the transformed weights is a 4D array with 4 * 4 * INPUT_DIM * NB_FILTER */
+	WEIGHT_T	weight[4][4][INPUT_DIM][NB_FILTER];
+	/*the bias is a 1D array with NB_FILTER */
+	WEIGHT_T	bias[NB_FILTER];
+
+public:
+	/*
+	 * @note: the feedback function
+	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM
+	 */
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res)
+	{
+		/* define a 4-row ring line buffer */
+		LineBufferRing<4, COL, INPUT_DIM, DATA_T>	line;
+
+		for( int row = 0; row < OUT_ROW; row += 2)
+		{
+			/* read the rows of the tile row that are not in the line buffer yet */
+			line.advance(data, row, ROW);
+
+			for( int col = 0; col < OUT_COL; col += 2)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				/* read the input tile of every input channel, the tile is padded with zero at the border */
+				DATA_T d[4][4][INPUT_DIM], y[2][2][NB_FILTER];
+#pragma HLS ARRAY_PARTITION variable=d dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=d dim=2 complete
+#pragma HLS ARRAY_PARTITION variable=y dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=y dim=2 complete
+				for( int c = 0; c < INPUT_DIM; c++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN || CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+					for( int i = 0; i < 4; i++)
+					{
+						for( int j = 0; j < 4; j++)
+							d[i][j][c] = (row + i < ROW && col + j < COL) ? line.getval(i, col + j, c) : (DATA_T)0;
+					}
+				}
+				winograd_tile<INPUT_DIM, NB_FILTER, AC_FN, DATA_T, WEIGHT_T, ACC_T>(d, weight, bias, y);
+
+				for( int i = 0; i < 2; i++)
+				{
+					for( int j = 0; j < 2; j++)
+					{
+						if( row + i < OUT_ROW && col + j < OUT_COL)
+						{
+							for( int k = 0; k < NB_FILTER; k++)
+								res[(row + i) * OUT_COL * NB_FILTER + (col + j) * NB_FILTER + k] = y[i][j][k];
+						}
+					}
+				}
+			}
+		}
+	}
+};
+
+/*
+ * @note: define the Convolution2D_DataStream layer fused with a MaxPooling2D layer,
+ * 	the convolution output never leaves the chip, only the pooled result is written to the AXI master
+ * 	DATA_T is the type of the output and the on chip buffers, WEIGHT_T of the weight and bias, ACC_T of the sum of products
+ */
+template<int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM = 1, ACTIVATION AC_FN=LINEAR, int SUBSAMPLE_ROW=1, int SUBSAMPLE_COL=1,
+		int POOL_ROW = 2, int POOL_COL = 2,
+		int CONV_ROW=(ROW - NB_ROW)/SUBSAMPLE_ROW + 1, int CONV_COL=(COL - NB_COL)/SUBSAMPLE_COL + 1,
+		int OUT_ROW=CONV_ROW/POOL_ROW, int OUT_COL=CONV_COL/POOL_COL,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class Convolution2DMaxPool2D_DataStream
+{
+public:
+	Convolution2DMaxPool2D_DataStream(const TYPE_T *WEIGHT, const TYPE_T *BIAS)
+	{
+		assert(ROW > NB_ROW);
+		assert(COL > NB_COL);
+		assert(OUT_ROW > 0);
+		assert(OUT_COL > 0);
+#pragma HLS ARRAY_PARTITION variable=weight dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=weight dim=2 complete
+
+#if DEBUG
+		cout<<"Convolution2DMaxPool2D_DataStream Layer......"<<endl;
+		cout<<"\tNB_FILTER = " << NB_FILTER << endl;
+		cout<<"\tNB_ROW = " << NB_ROW << endl;
+		cout<<"\tNB_COL = " << NB_COL << endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tINPUT_DIM = "<<INPUT_DIM << endl;
+		cout<<"\tSUBSAMPLE_ROW = " << SUBSAMPLE_ROW << endl;
+		cout<<"\tSUBSAMPLE_COL = " << SUBSAMPLE_COL << endl;
+		cout<<"\tPOOL_ROW = " << POOL_ROW << endl;
+		cout<<"\tPOOL_COL = " << POOL_COL << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+#endif
+
+		/* initialize the weight and bias */
+		for( int i = 0; i < NB_ROW; i++)
+		{
+			for( int j = 0; j < NB_COL; j++)
+			{
+				for( int m = 0; m < INPUT_DIM; m++)
+				{
+					for(int n = 0; n < NB_FILTER; n++)
+						weight[i][j][m][n] = WEIGHT[ i*NB_COL*INPUT_DIM*NB_FILTER + j*INPUT_DIM*NB_FILTER + m*NB_FILTER + n];
+				}
+			}
+		}
+		for( int i = 0; i < NB_FILTER; i++)
+		{
+			bias[i] = BIAS[i];
+		}
+	}
+public:
+	/*the weights is a 4D array with NB_ROW * NB_COL * INPUT_DIM * NB_FILTER */
+	WEIGHT_T	weight[NB_ROW][NB_COL][INPUT_DIM][NB_FILTER];
+	/*the bias is a 1D array with NB_FILTER */
+	WEIGHT_T	bias[NB_FILTER];
+
+public:
+	/*
+	 * @note: the feedback function
+	 * @params: the input data is a 3D array, ROW * COL * INPUT_DIM, the output is OUT_ROW * OUT_COL * NB_FILTER,
+	 * 	the input is converted to DATA_T when it is read
+	 */
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res)
+	{
+#if HOST_NATIVE
+		/* the whole convolution output followed by the pooling */
+		static DATA_T	conv[CONV_ROW][CONV_COL][NB_FILTER];
+		host_convolution2D<DATA_T, ACC_T, NB_FILTER, NB_ROW, NB_COL, ROW, COL, INPUT_DIM, AC_FN, SUBSAMPLE_ROW, SUBSAMPLE_COL, CONV_ROW, CONV_COL>(
+				(const IN_T *)data, &weight[0][0][0][0], bias, &conv[0][0][0]);
+		for( int row = 0; row < OUT_ROW; row++)
+		{
+			for( int col = 0; col < OUT_COL; col++)
+			{
+				for( int k = 0; k < NB_FILTER; k++)
+				{
+					DATA_T max = conv[row * POOL_ROW][col * POOL_COL][k];
+					for( int m = 0; m < POOL_ROW; m++)
+					{
+						for( int n = 0; n < POOL_COL; n++)
+						{
+							DATA_T v = conv[row * POOL_ROW + m][col * POOL_COL + n][k];
+							if( v > max )
+								max = v;
+						}
+					}
+					res[(row * OUT_COL + col) * NB_FILTER + k] = max;
+				}
+			}
+		}
+		return;
+#endif
+		/* define a NB_ROW ring line buffer, each input element is read once from the AXI master */
+		LineBufferRing<NB_ROW, COL, INPUT_DIM, DATA_T>	line;
+
+		/* the running maximum of the current pooled row */
+		DATA_T	pool[OUT_COL][NB_FILTER];
+
+		/* only the convolution rows covered by the pooling are calculated */
+		for( int row = 0; row < OUT_ROW * POOL_ROW; row++)
+		{
+			/* read the rows of the window that are not in the line buffer yet */
+			line.advance(data, row * SUBSAMPLE_ROW, ROW);
+
+			/* process the 2D convolution of one row and pool it on chip */
+			for( int col = 0; col < OUT_COL * POOL_COL; col++)
+			{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				for (int k = 0; k < NB_FILTER; k++)
+				{
+#if CONVOLUTION2D_PERF_MODE == PERF_HIGH || CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS LOOP_FLATTEN
+#endif
+#if CONVOLUTION2D_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+					/* calculate the weight and bias */
+					ACC_T t = bias[k];
+
+					for (int m = 0; m < NB_ROW; m++)
+					{
+						for (int n = 0; n < NB_COL; n++)
+						{
+							for (int v = 0; v < INPUT_DIM; v++)
+							{
+#if CONVOLUTION2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+								DATA_T val = line.getval(m, col * SUBSAMPLE_COL + n, v);
+								t += val * weight[m][n][v][k];
+							}
+						}
+					}
+
+					/* calculate the activation function */
+					DATA_T a = activation_fn<AC_FN, DATA_T>((DATA_T)t);
+
+					/* update the maximum value in the local window */
+					int p = col / POOL_COL;
+					if( (row % POOL_ROW == 0 && col % POOL_COL == 0) || a > pool[p][k] )
+						pool[p][k] = a;
+				}
+			}
+
+			/* write the pooled row after its last convolution row */
+			if( row % POOL_ROW == POOL_ROW - 1 )
+			{
+				for( int col = 0; col < OUT_COL; col++)
+				{
+					for( int k = 0; k < NB_FILTER; k++)
+					{
+#pragma HLS pipeline
+						res[(row / POOL_ROW) * OUT_COL * NB_FILTER + col * NB_FILTER + k] = pool[col][k];
+					}
 				}
 			}
 		}
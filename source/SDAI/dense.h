@@ -7,6 +7,12 @@
 
 #include "activation.h"
 #include "configure.h"
+#include "stream.h"
+#include "host.h"
+#include "calibration.h"
+#include "quantize.h"
+#include "binary.h"
+#include "pow2.h"
 #include "mem.h"
 #include <assert.h>
 #include <string.h>
@@ -22,8 +28,9 @@ namespace SDAI
  * @note: the Fully Connected Layer: Dense Layer
  * 	the input_shape = {INPUT_DIM}
  * 	the output shape = {OUTPUT_DIM}
+ * 	DATA_T is the type of the input and output, WEIGHT_T of the weight and bias, ACC_T of the sum of products
  */
-template<int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN>
+template<int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN, typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
 class Dense
 {
 public:
@@ -42,18 +49,40 @@ public:
 			for( int j = 0; j < OUTPUT_DIM; j++)
 				weight[i][j] = WEIGHT[i*OUTPUT_DIM + j];
 		}
+#if CALIBRATION_HOST
+		calib = calibration().find("Dense", WEIGHT);
+		calibration().weight(calib, &weight[0][0], (INPUT_DIM + 1) * OUTPUT_DIM);
+#endif
 	}
 public:
-	TYPE_T	weight[INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T	res[OUTPUT_DIM];
+	WEIGHT_T	weight[INPUT_DIM + 1][OUTPUT_DIM];
+	DATA_T		res[OUTPUT_DIM];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 	/*
 	 * @note: the feedforword function
-	 * @params: the input data is a 1D array with INPUT_DIM
+	 * @params: the input data is a 1D array with INPUT_DIM, it is converted to DATA_T on read
 	 */
-	void feedforward(TYPE_T data[INPUT_DIM])
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_DIM])
 	{
+#if HOST_NATIVE
+		/* the row vector times the row major weight */
+		host_gemv<DATA_T, ACC_T, OUTPUT_DIM, INPUT_DIM>(data, &weight[0][0], weight[INPUT_DIM], res);
+		activation_apply<AC_FN, OUTPUT_DIM>(res);
+		if( AC_FN == SOFTMAX )
+		{
+			activation_softmax<OUTPUT_DIM>(res);
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, res, OUTPUT_DIM);
+#endif
+		return;
+#endif
 		for( int i = 0; i < OUTPUT_DIM; i++)
 		{
 #if DENSE_PERF_MODE == PERF_HIGH
@@ -61,17 +90,17 @@ public:
 #endif
 
 			/* calculate the weight and bias*/
-			TYPE_T tmp = weight[INPUT_DIM][i];
+			ACC_T tmp = weight[INPUT_DIM][i];
 			for(int j = 0; j < INPUT_DIM; j++)
 			{
 #if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
 #pragma HLS pipeline
 #endif
-				tmp += data[j] * weight[j][i];
+				tmp += (DATA_T)data[j] * weight[j][i];
 			}
 
 			/* calculate the activation function */
-			res[i] = activation_fn<AC_FN>(tmp);
+			res[i] = activation_fn<AC_FN, DATA_T>((DATA_T)tmp);
 		}
 
 		/* for the activation of softmax */
@@ -79,6 +108,316 @@ public:
 		{
 			activation_softmax<OUTPUT_DIM>(res);
 		}
+#if CALIBRATION_HOST
+		calibration().data(calib, res, OUTPUT_DIM);
+#endif
+	}
+
+	/*
+	 * @note: the feedforword function with FIFO channels, one sample of INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_DIM];
+		for( int j = 0; j < INPUT_DIM; j++)
+		{
+#pragma HLS pipeline
+			data[j] = in.read();
+		}
+
+		feedforward(data);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
+};
+
+/*
+ * @note: the Fully Connected Layer for a batch of samples, each weight is loaded once and shared by the whole batch
+ * 	the input_shape = {NB_BATCH, INPUT_DIM}
+ * 	the output shape = {NB_BATCH, OUTPUT_DIM}
+ * 	DATA_T is the type of the input and output, WEIGHT_T of the weight and bias, ACC_T of the sum of products
+ */
+template<int NB_BATCH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN, typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class Dense_Batch
+{
+public:
+	Dense_Batch(const TYPE_T *WEIGHT)
+	{
+		assert(NB_BATCH > 0);
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+#pragma HLS ARRAY_PARTITION variable=res dim=1 complete
+#if DEBUG
+		cout<<"Dense_Batch Layer......"<<endl;
+		cout<<"\tNB_BATCH = " << NB_BATCH << endl;
+		cout<<"\tINPUT_DIM = " << INPUT_DIM << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+#endif
+		/* initialize the weight */
+		for( int i = 0; i < INPUT_DIM + 1; i++)
+		{
+			for( int j = 0; j < OUTPUT_DIM; j++)
+				weight[i][j] = WEIGHT[i*OUTPUT_DIM + j];
+		}
+	}
+public:
+	WEIGHT_T	weight[INPUT_DIM + 1][OUTPUT_DIM];
+	DATA_T		res[NB_BATCH][OUTPUT_DIM];
+
+public:
+	/*
+	 * @note: the feedforword function
+	 * @params: the input data is a 2D array with NB_BATCH x INPUT_DIM, it is converted to DATA_T on read
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[NB_BATCH][INPUT_DIM])
+	{
+#if HOST_NATIVE
+		{
+			ACC_T	acc[NB_BATCH][OUTPUT_DIM];
+			host_gemm<DATA_T>(NB_BATCH, OUTPUT_DIM, INPUT_DIM, &data[0][0], INPUT_DIM, &weight[0][0], OUTPUT_DIM, weight[INPUT_DIM], &acc[0][0], OUTPUT_DIM);
+			for( int n = 0; n < NB_BATCH; n++)
+			{
+				for( int i = 0; i < OUTPUT_DIM; i++)
+				{
+					res[n][i] = (DATA_T)acc[n][i];
+				}
+				activation_apply<AC_FN, OUTPUT_DIM>(res[n]);
+				if( AC_FN == SOFTMAX )
+				{
+					activation_softmax<OUTPUT_DIM>(res[n]);
+				}
+			}
+			return;
+		}
+#endif
+#pragma HLS ARRAY_PARTITION variable=data dim=1 complete
+		/* the accumulator of each sample */
+		ACC_T	acc[NB_BATCH];
+#pragma HLS ARRAY_PARTITION variable=acc dim=1 complete
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#if DENSE_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+			/* add the bias */
+			WEIGHT_T b = weight[INPUT_DIM][i];
+			for( int n = 0; n < NB_BATCH; n++)
+			{
+#pragma HLS unroll
+				acc[n] = b;
+			}
+
+			/* calculate the weight, every weight is read once for the whole batch */
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+				WEIGHT_T w = weight[j][i];
+				for( int n = 0; n < NB_BATCH; n++)
+				{
+#pragma HLS unroll
+					acc[n] += (DATA_T)data[n][j] * w;
+				}
+			}
+
+			/* calculate the activation function */
+			for( int n = 0; n < NB_BATCH; n++)
+			{
+#if DENSE_PERF_MODE == PERF_HIGH
+#pragma HLS unroll
+#else
+#pragma HLS pipeline
+#endif
+				res[n][i] = activation_fn<AC_FN, DATA_T>((DATA_T)acc[n]);
+			}
+		}
+
+		/* for the activation of softmax */
+		if( AC_FN == SOFTMAX )
+		{
+			for( int n = 0; n < NB_BATCH; n++)
+			{
+				activation_softmax<OUTPUT_DIM>(res[n]);
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedforword function with FIFO channels, NB_BATCH samples are read and written in order
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[NB_BATCH][INPUT_DIM];
+		for( int n = 0; n < NB_BATCH; n++)
+		{
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				data[n][j] = in.read();
+			}
+		}
+
+		feedforward(data);
+
+		for( int n = 0; n < NB_BATCH; n++)
+		{
+			for( int i = 0; i < OUTPUT_DIM; i++)
+			{
+#pragma HLS pipeline
+				out.write(res[n][i]);
+			}
+		}
+	}
+};
+
+/*
+ * @note: the Fully Connected Layer used as the classification head, the outputs are not kept,
+ * 	only the TOP_K best categories are tracked while the outputs are calculated
+ * 	the score is the output before softmax, or the softmax probability with PROBABILITY = true,
+ * 	so no exp or division is used unless the probability is requested
+ * 	the input_shape = {INPUT_DIM}
+ * 	the output shape = {TOP_K}
+ * 	DATA_T is the type of the input and the score, WEIGHT_T of the weight and bias, ACC_T of the sum of products
+ */
+template<int INPUT_DIM, int OUTPUT_DIM, int TOP_K = 1, bool PROBABILITY = false,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class Dense_Category
+{
+public:
+	Dense_Category(const TYPE_T *WEIGHT)
+	{
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+		assert(TOP_K > 0 && TOP_K <= OUTPUT_DIM);
+#pragma HLS ARRAY_PARTITION variable=res dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=score dim=1 complete
+#if DEBUG
+		cout<<"Dense_Category Layer......"<<endl;
+		cout<<"\tINPUT_DIM = " << INPUT_DIM << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tTOP_K = " << TOP_K << endl;
+#endif
+		/* initialize the weight */
+		for( int i = 0; i < INPUT_DIM + 1; i++)
+		{
+			for( int j = 0; j < OUTPUT_DIM; j++)
+				weight[i][j] = WEIGHT[i*OUTPUT_DIM + j];
+		}
+	}
+public:
+	WEIGHT_T	weight[INPUT_DIM + 1][OUTPUT_DIM];
+	/* the categories from the best one, and their scores */
+	TYPE_PINT	res[TOP_K];
+	DATA_T		score[TOP_K];
+
+public:
+	/*
+	 * @note: the feedforword function
+	 * @params: the input data is a 1D array with INPUT_DIM
+	 * @return: the best category, the same as utils_find_category on the softmax output of Dense
+	 */
+	template<typename IN_T>
+	TYPE_PINT feedforward(IN_T data[INPUT_DIM])
+	{
+		/* the running maximum and the sum of exp(out - max) for the probability */
+		DATA_T max = 0;
+		DATA_T sum = 0;
+
+#if HOST_NATIVE
+		/* all the outputs at once as the row vector times the row major weight */
+		DATA_T	out[OUTPUT_DIM];
+		host_gemv<DATA_T, ACC_T, OUTPUT_DIM, INPUT_DIM>(data, &weight[0][0], weight[INPUT_DIM], out);
+#endif
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#if DENSE_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+
+#if HOST_NATIVE
+			DATA_T tmp = out[i];
+#else
+			/* calculate the weight and bias*/
+			ACC_T acc = weight[INPUT_DIM][i];
+			for(int j = 0; j < INPUT_DIM; j++)
+			{
+#if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+				acc += (DATA_T)data[j] * weight[j][i];
+			}
+			DATA_T tmp = (DATA_T)acc;
+#endif
+
+			insert(i, tmp);
+
+			if( PROBABILITY )
+			{
+				if( i == 0 )
+				{
+					max = tmp;
+					sum = 1;
+				}
+				else
+				{
+					activation_softmax_step(tmp, max, sum);
+				}
+			}
+		}
+
+		/* turn the scores into the softmax probability */
+		if( PROBABILITY )
+		{
+			DATA_T scale = 1.0/sum;
+			for( int k = 0; k < TOP_K; k++)
+			{
+#pragma HLS pipeline
+				score[k] = expf(score[k] - max) * scale;
+			}
+		}
+
+		return res[0];
+	}
+
+private:
+	/*
+	 * @note: insert the output i into the sorted top-k, a slot not filled yet is taken by any output
+	 * 	and the earlier output stays in front when two are equal
+	 */
+	void insert(int i, DATA_T v)
+	{
+#pragma HLS inline
+		for( int k = TOP_K - 1; k > 0; k--)
+		{
+#pragma HLS unroll
+			bool above_prev = (k - 1 >= i) || (v > score[k - 1]);
+			bool above = (k >= i) || (v > score[k]);
+			if( above_prev )
+			{
+				score[k] = score[k - 1];
+				res[k] = res[k - 1];
+			}
+			else if( above )
+			{
+				score[k] = v;
+				res[k] = i;
+			}
+		}
+		if( i == 0 || v > score[0] )
+		{
+			score[0] = v;
+			res[0] = i;
+		}
 	}
 };
 
@@ -86,8 +425,9 @@ public:
  * @note: the Fully Connected Layer with streamed weight
  * 	the input_shape = {INPUT_DIM}
  * 	the output shape = {OUTPUT_DIM}
+ * 	DATA_T is the type of the input and output, WEIGHT_T of the streamed weight and bias, ACC_T of the sum of products
  */
-template<int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN>
+template<int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN, typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
 class Dense_WeightStream
 {
 public:
@@ -102,17 +442,51 @@ public:
 #endif
 	}
 public:
-	TYPE_T	res[OUTPUT_DIM];
+	DATA_T	res[OUTPUT_DIM];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 	/*
 	 * @note: the feedforword function
-	 * @params: the input data is a 1D array with INPUT_DIM
+	 * @params: the input data is a 1D array with INPUT_DIM, it is converted to DATA_T on read
 	 */
-	void feedforward(volatile TYPE_T *weight, TYPE_T data[INPUT_DIM])
+	template<typename IN_T>
+	void feedforward(volatile WEIGHT_T *weight, IN_T data[INPUT_DIM])
 	{
+#if CALIBRATION_HOST
+		calib = calibration().find("Dense_WeightStream", (const void *)weight);
+		weight = calibration().weight_stream(calib, weight, OUTPUT_DIM * (INPUT_DIM + 1));
+#endif
+#if DENSE_OPT_MODE == OPT_BUFFER
+		/* define two 1D line buffers used as ping-pong banks */
+		LineBuffer1D<INPUT_DIM + 1, WEIGHT_T>		ping;
+		LineBuffer1D<INPUT_DIM + 1, WEIGHT_T>		pong;
+
+		/* copy the first row before the computation starts */
+		ping.fill(&weight[0]);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#if DENSE_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+			/* compute row i from one bank while row i + 1 is burst into the other */
+			bool prefetch = (i + 1 < OUTPUT_DIM);
+			ACC_T tmp;
+			if( i % 2 == 0 )
+				tmp = mac_prefetch(ping, pong, &weight[(i + 1) * (INPUT_DIM + 1)], prefetch, data);
+			else
+				tmp = mac_prefetch(pong, ping, &weight[(i + 1) * (INPUT_DIM + 1)], prefetch, data);
+
+			/* calculate the activation function */
+			res[i] = activation_fn<AC_FN, DATA_T>((DATA_T)tmp);
+		}
+#else
 		/* define a 1D line buffer */
-		LineBuffer1D<INPUT_DIM + 1>		buffer;
+		LineBuffer1D<INPUT_DIM + 1, WEIGHT_T>		buffer;
 
 		for( int i = 0; i < OUTPUT_DIM; i++)
 		{
@@ -123,18 +497,302 @@ public:
 			buffer.fill(&weight[i * (INPUT_DIM + 1)]);
 
 			/* calculate the weight and bias*/
-			TYPE_T tmp = buffer.getval( INPUT_DIM );
+			ACC_T tmp = buffer.getval( INPUT_DIM );
+
+			for(int j = 0; j < INPUT_DIM; j++)
+			{
+#if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+				tmp += (DATA_T)data[j] * buffer.getval(j);
+			}
+
+			/* calculate the activation function */
+			res[i] = activation_fn<AC_FN, DATA_T>((DATA_T)tmp);
+		}
+#endif
+
+		/* for the activation of softmax */
+		if( AC_FN == SOFTMAX )
+		{
+			activation_softmax<OUTPUT_DIM>(res);
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, res, OUTPUT_DIM);
+#endif
+	}
+
+	/*
+	 * @note: the feedforword function with FIFO channels, one sample of INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	template<typename IN_T>
+	void feedforward(volatile WEIGHT_T *weight, hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_DIM];
+		for( int j = 0; j < INPUT_DIM; j++)
+		{
+#pragma HLS pipeline
+			data[j] = in.read();
+		}
+
+		feedforward(weight, data);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
 
+private:
+	/*
+	 * @note: multiply the row in cur and, in the same loop, burst the next row into next,
+	 * 	the loop is scheduled by DENSE_PERF_MODE as the loop of the single buffer
+	 */
+	template<typename IN_T>
+	ACC_T mac_prefetch(LineBuffer1D<INPUT_DIM + 1, WEIGHT_T> &cur, LineBuffer1D<INPUT_DIM + 1, WEIGHT_T> &next, volatile WEIGHT_T *weight,
+			bool prefetch, IN_T data[INPUT_DIM])
+	{
+#pragma HLS inline
+		/* calculate the weight and bias*/
+		ACC_T tmp = cur.getval( INPUT_DIM );
+
+		for( int j = 0; j < INPUT_DIM + 1; j++)
+		{
+#if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+			if( prefetch )
+				next.getval(j) = weight[j];
+			if( j < INPUT_DIM )
+				tmp += (DATA_T)data[j] * cur.getval(j);
+		}
+		return tmp;
+	}
+};
+
+
+/*
+ * @note: the int8 Fully Connected Layer, the weight is int8 with a scale per output, the sum of products is int32
+ * 	and it is requantized to the int8 output with a fixed point multiplier and shift, see quantize.h
+ * 	the input_shape = {INPUT_DIM}
+ * 	the output shape = {OUTPUT_DIM}
+ * 	IN_SCALE and OUT_SCALE are the real values of one step of the int8 input and output,
+ * 	AC_FN can only be LINEAR or RELU, the category of a classifier is the maximum of the LINEAR output
+ */
+template<int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN>
+class Dense_Int8
+{
+public:
+	Dense_Int8(const TYPE_T *WEIGHT, float IN_SCALE, float OUT_SCALE)
+	{
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+		assert(AC_FN == LINEAR || AC_FN == RELU);
+#if DEBUG
+		cout<<"Dense_Int8 Layer......"<<endl;
+		cout<<"\tINPUT_DIM = " << INPUT_DIM << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tIN_SCALE = " << IN_SCALE << endl;
+		cout<<"\tOUT_SCALE = " << OUT_SCALE << endl;
+#endif
+		/* initialize the weight, the bias is the last row of WEIGHT */
+		quantize_weight_int8<INPUT_DIM, OUTPUT_DIM>(WEIGHT, &WEIGHT[INPUT_DIM * OUTPUT_DIM], IN_SCALE, OUT_SCALE,
+				&weight[0][0], bias, mult, shift);
+	}
+public:
+	TYPE_INT8	weight[INPUT_DIM][OUTPUT_DIM];
+	TYPE_INT32	bias[OUTPUT_DIM];
+	/* the requantization of each output */
+	TYPE_INT32	mult[OUTPUT_DIM];
+	int			shift[OUTPUT_DIM];
+	TYPE_INT8	res[OUTPUT_DIM];
+
+public:
+	/*
+	 * @note: the feedforword function
+	 * @params: the input data is a 1D int8 array with INPUT_DIM
+	 */
+	void feedforward(TYPE_INT8 data[INPUT_DIM])
+	{
+#if HOST_NATIVE
+		TYPE_INT32 acc[OUTPUT_DIM];
+		host_gemv<TYPE_INT32, TYPE_INT32, OUTPUT_DIM, INPUT_DIM>(data, &weight[0][0], bias, acc);
+		for( int i = 0; i < OUTPUT_DIM; i++)
+			res[i] = requantize<AC_FN>(acc[i], mult[i], shift[i]);
+		return;
+#endif
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#if DENSE_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+			/* calculate the weight and bias */
+			TYPE_INT32 tmp = bias[i];
+			for(int j = 0; j < INPUT_DIM; j++)
+			{
+#if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+				tmp += data[j] * weight[j][i];
+			}
+
+			/* requantize and calculate the activation function */
+			res[i] = requantize<AC_FN>(tmp, mult[i], shift[i]);
+		}
+	}
+
+	/*
+	 * @note: the feedforword function with FIFO channels, one sample of INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	void feedforward(hls::stream<TYPE_INT8> &in, hls::stream<TYPE_INT8> &out)
+	{
+		TYPE_INT8 data[INPUT_DIM];
+		for( int j = 0; j < INPUT_DIM; j++)
+		{
+#pragma HLS pipeline
+			data[j] = in.read();
+		}
+
+		feedforward(data);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
+};
+
+
+/*
+ * @note: the binarized Fully Connected Layer, the weight and the input are +1 or -1 packed into words, see binary.h
+ * 	the dot product is an XNOR and a popcount and the activation is the threshold of the folded bias and batch normalization
+ * 	the input_shape = {INPUT_DIM}, it is packed in groups of INPUT_GROUP as by binary_pack, e.g. NB_FILTER after Convolution2D_Binary
+ * 	the output shape = {OUTPUT_DIM}, packed in one group
+ * 	the weight and bias are the float WEIGHT of Dense, only the sign of the weight is kept
+ */
+template<int INPUT_DIM, int OUTPUT_DIM, int INPUT_GROUP = INPUT_DIM>
+class Dense_Binary
+{
+public:
+	Dense_Binary(const TYPE_T *WEIGHT, const TYPE_T *BATCHNORM = 0)
+	{
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+		assert(INPUT_DIM % INPUT_GROUP == 0);
+#if DEBUG
+		cout<<"Dense_Binary Layer......"<<endl;
+		cout<<"\tINPUT_DIM = " << INPUT_DIM << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tINPUT_GROUP = " << INPUT_GROUP << endl;
+#endif
+		/* initialize the weight, the bias is the last row of WEIGHT */
+		binary_pack_weight<INPUT_DIM, OUTPUT_DIM, INPUT_GROUP>(WEIGHT, &weight[0][0]);
+		binary_threshold<INPUT_DIM, OUTPUT_DIM>(&WEIGHT[INPUT_DIM * OUTPUT_DIM], BATCHNORM, threshold, positive);
+	}
+public:
+	TYPE_BWORD	weight[OUTPUT_DIM][INPUT_DIM / INPUT_GROUP * BINARY_NB_WORD(INPUT_GROUP)];
+	TYPE_INT32	threshold[OUTPUT_DIM];
+	bool		positive[OUTPUT_DIM];
+	/* the dot product of each output before the threshold, the score of a binary classifier */
+	TYPE_INT32	acc[OUTPUT_DIM];
+	TYPE_BWORD	res[BINARY_NB_WORD(OUTPUT_DIM)];
+
+public:
+	/*
+	 * @note: the feedforword function
+	 * @params: the input data is a packed 1D array with INPUT_DIM values
+	 */
+	void feedforward(TYPE_BWORD data[INPUT_DIM / INPUT_GROUP * BINARY_NB_WORD(INPUT_GROUP)])
+	{
+		const int NB_WORD = INPUT_DIM / INPUT_GROUP * BINARY_NB_WORD(INPUT_GROUP);
+
+		for( int i = 0; i < BINARY_NB_WORD(OUTPUT_DIM); i++)
+			res[i] = 0;
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#if DENSE_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+			/* count the different signs */
+			int diff = 0;
+			for( int j = 0; j < NB_WORD; j++)
+			{
+#if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+				diff += binary_popcount(data[j] ^ weight[i][j]);
+			}
+			acc[i] = INPUT_DIM - 2 * diff;
+
+			/* calculate the threshold activation */
+			if( binary_activation(acc[i], threshold[i], positive[i]) )
+				res[i / BINARY_WORD_BITS] |= (TYPE_BWORD)1 << (i % BINARY_WORD_BITS);
+		}
+	}
+};
+
+
+/*
+ * @note: the Fully Connected Layer with power of two weights, each weight is NB_TERM terms +-2^e, see pow2.h,
+ * 	so a product of the data and a weight is NB_TERM shifts and additions in ACC_T
+ * 	the input_shape = {INPUT_DIM}
+ * 	the output shape = {OUTPUT_DIM}
+ * 	the weight is converted from the float WEIGHT of Dense, the bias is kept in ACC_T
+ */
+template<int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN, int NB_TERM = 1, typename DATA_T = TYPE_T, typename ACC_T = TYPE_T>
+class Dense_Pow2
+{
+public:
+	Dense_Pow2(const TYPE_T *WEIGHT)
+	{
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+		assert(NB_TERM > 0);
+#if DEBUG
+		cout<<"Dense_Pow2 Layer......"<<endl;
+		cout<<"\tINPUT_DIM = " << INPUT_DIM << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tNB_TERM = " << NB_TERM << endl;
+#endif
+		/* initialize the weight and bias */
+		pow2_convert<NB_TERM>(WEIGHT, INPUT_DIM * OUTPUT_DIM, &weight[0][0][0]);
+		for( int i = 0; i < OUTPUT_DIM; i++)
+			bias[i] = WEIGHT[INPUT_DIM * OUTPUT_DIM + i];
+	}
+public:
+	TYPE_POW2	weight[INPUT_DIM][OUTPUT_DIM][NB_TERM];
+	ACC_T		bias[OUTPUT_DIM];
+	DATA_T		res[OUTPUT_DIM];
+
+public:
+	/*
+	 * @note: the feedforword function
+	 * @params: the input data is a 1D array with INPUT_DIM, it is converted to DATA_T on read
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_DIM])
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#if DENSE_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+			/* calculate the weight and bias*/
+			ACC_T tmp = bias[i];
 			for(int j = 0; j < INPUT_DIM; j++)
 			{
 #if DENSE_PERF_MODE == PERF_LOW || DENSE_PERF_MODE == PERF_MEDIAN
 #pragma HLS pipeline
 #endif
-				tmp += data[j] * buffer.getval(j);
+				for( int s = 0; s < NB_TERM; s++)
+					pow2_mac(tmp, (DATA_T)data[j], weight[j][i][s]);
 			}
 
 			/* calculate the activation function */
-			res[i] = activation_fn<AC_FN>(tmp);
+			res[i] = activation_fn<AC_FN, DATA_T>((DATA_T)tmp);
 		}
 
 		/* for the activation of softmax */
@@ -5,6 +5,8 @@
 #ifndef __EMBEDDING_H__
 #define __EMBEDDING_H__
 #include "configure.h"
+#include "stream.h"
+#include "calibration.h"
 
 #if DEBUG
 #include <iostream>
@@ -14,12 +16,29 @@ using namespace std;
 
 namespace SDAI
 {
+/*
+ * @note: the true length of a post-padded sample, the number of indexes before the first MASK index
+ */
+template<int INPUT_LENGTH>
+int sequence_length(TYPE_PINT data[INPUT_LENGTH], TYPE_PINT MASK = 0)
+{
+	int length = INPUT_LENGTH;
+	for( int j = INPUT_LENGTH - 1; j >= 0; j--)
+	{
+#pragma HLS pipeline
+		if( data[j] == MASK )
+			length = j;
+	}
+	return length;
+}
+
 /*
  * @note: define the Embedding layer
  * 	***This layer can only be used as the first layer in a model.
  * 	***The input data of this layer must be positive integer data type
+ * 	the table is kept in WEIGHT_T and the looked up rows are converted to DATA_T
  */
-template<int INPUT_DIM, int OUTPUT_DIM, int NB_SAMPLES, int INPUT_LENGTH  >
+template<int INPUT_DIM, int OUTPUT_DIM, int NB_SAMPLES, int INPUT_LENGTH, typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T>
 class Embedding
 {
 public:
@@ -40,11 +59,14 @@ public:
 				weight[i][j] = WEIGHT[i * OUTPUT_DIM + j];
 			}
 		}
+#if CALIBRATION_HOST
+		calibration().weight(calibration().find("Embedding", WEIGHT), &weight[0][0], INPUT_DIM * OUTPUT_DIM);
+#endif
 	}
 
 public:
-	TYPE_T weight[INPUT_DIM][OUTPUT_DIM];
-	TYPE_T res[NB_SAMPLES][INPUT_LENGTH][OUTPUT_DIM];
+	WEIGHT_T	weight[INPUT_DIM][OUTPUT_DIM];
+	DATA_T		res[NB_SAMPLES][INPUT_LENGTH][OUTPUT_DIM];
 
 public:
 	/*
@@ -68,18 +90,63 @@ public:
 #if EMBEDDING_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-					res[i][j][k] = weight[index][k];
+					res[i][j][k] = (DATA_T)weight[index][k];
+				}
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedforward function of padded samples, only the first length[i] indexes of sample i are looked up
+	 * 	and the rows after them in res are left untouched
+	 */
+	void feedforward( TYPE_PINT data[NB_SAMPLES][INPUT_LENGTH], int length[NB_SAMPLES] )
+	{
+		for( int i = 0; i < NB_SAMPLES; i++)
+		{
+			int len = length[i];
+			for( int j = 0; j < INPUT_LENGTH; j++)
+			{
+#if EMBEDDING_PERF_MODE == PERF_MEDIAN || EMBEDDING_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				if( j == len )
+					break;
+				TYPE_PINT index = data[i][j];
+				for( int k = 0; k < OUTPUT_DIM; k++)
+				{
+#if EMBEDDING_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+					res[i][j][k] = (DATA_T)weight[index][k];
 				}
 			}
 		}
 	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, each index read gives OUTPUT_DIM values
+	 */
+	void feedforward(hls::stream<TYPE_PINT> &in, hls::stream<DATA_T> &out)
+	{
+		for( int i = 0; i < NB_SAMPLES * INPUT_LENGTH; i++)
+		{
+			TYPE_PINT index = in.read();
+			for( int k = 0; k < OUTPUT_DIM; k++)
+			{
+#pragma HLS pipeline
+				out.write((DATA_T)weight[index][k]);
+			}
+		}
+	}
 };
 
 
 /*
  * @note: define a data stream based Embedding layer
+ * 	the table is kept in WEIGHT_T and the looked up rows are written as DATA_T
  */
-template<int INPUT_DIM, int OUTPUT_DIM, int NB_SAMPLES, int INPUT_LENGTH  >
+template<int INPUT_DIM, int OUTPUT_DIM, int NB_SAMPLES, int INPUT_LENGTH, typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T>
 class Embedding_DataStream
 {
 public:
@@ -100,16 +167,19 @@ public:
 				weight[i][j] = WEIGHT[i * OUTPUT_DIM + j];
 			}
 		}
+#if CALIBRATION_HOST
+		calibration().weight(calibration().find("Embedding_DataStream", WEIGHT), &weight[0][0], INPUT_DIM * OUTPUT_DIM);
+#endif
 	}
 
 public:
-	TYPE_T weight[INPUT_DIM][OUTPUT_DIM];
+	WEIGHT_T	weight[INPUT_DIM][OUTPUT_DIM];
 
 public:
 	/*
 	 * @note: the feedforward function
 	 */
-	void feedforward(volatile TYPE_PINT *data, volatile TYPE_T *res)
+	void feedforward(volatile TYPE_PINT *data, volatile DATA_T *res)
 	{
 		for( int i = 0; i < NB_SAMPLES; i++)
 		{
@@ -127,7 +197,35 @@ public:
 #if EMBEDDING_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-					res[ i * INPUT_LENGTH * OUTPUT_DIM + j * OUTPUT_DIM + k] = weight[index][k];
+					res[ i * INPUT_LENGTH * OUTPUT_DIM + j * OUTPUT_DIM + k] = (DATA_T)weight[index][k];
+				}
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedforward function of padded samples, only the first length[i] indexes of sample i are looked up
+	 * 	and the rows after them in res are not written
+	 */
+	void feedforward(volatile TYPE_PINT *data, volatile DATA_T *res, volatile int *length)
+	{
+		for( int i = 0; i < NB_SAMPLES; i++)
+		{
+			int len = length[i];
+			for( int j = 0; j < INPUT_LENGTH; j++)
+			{
+#if EMBEDDING_PERF_MODE == PERF_MEDIAN || EMBEDDING_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				if( j == len )
+					break;
+				TYPE_PINT index = data[i * INPUT_LENGTH + j];
+				for( int k = 0; k < OUTPUT_DIM; k++)
+				{
+#if EMBEDDING_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+					res[ i * INPUT_LENGTH * OUTPUT_DIM + j * OUTPUT_DIM + k] = (DATA_T)weight[index][k];
 				}
 			}
 		}
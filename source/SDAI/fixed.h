@@ -0,0 +1,528 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __FIXED_H__
+#define __FIXED_H__
+#include <ap_fixed.h>
+#include <math.h>
+
+namespace SDAI
+{
+
+/*
+ * @note: Fixed<W, I, Q, O> emulates the signed ap_fixed<W, I, Q, O> of C simulation with the native integers,
+ * 	the value is the W bit integer V scaled by 2^-(W - I), W is at most 32
+ * 	like ap_fixed the result of an arithmetic operation is exact, it is kept as Fixed_Wide<F> (a 64 bit integer
+ * 	with F fraction bits) and only quantized with Q and wrapped or saturated with O when it is assigned to a Fixed,
+ * 	so the emulation is bit accurate as long as the exact intermediate results fit in 64 bits
+ * 	the operations with float or double are done in double, as ap_fixed converts itself to double
+ * 	AP_WRAP_SM and the saturation bits N of ap_fixed are not supported
+ */
+template<int W, int I, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP>
+class Fixed;
+
+template<int F>
+class Fixed_Wide;
+
+#define FIXED_MAX(a, b)		((a) > (b) ? (a) : (b))
+
+/*
+ * @note: 2^N as a 64 bit integer and as a double
+ */
+template<int N>
+struct Fixed_Pow2
+{
+	static const long long value = 1LL << N;
+	static double scale()
+	{
+		return N >= 0 ? (double)(1LL << (N >= 0 ? N : 0)) : 1.0 / (double)(1LL << (N < 0 ? -N : 0));
+	}
+};
+
+/*
+ * @note: the fraction bits of the exact result, FA and FB are the fraction bits of the operands
+ */
+template<int FA, int FB>
+struct Fixed_Frac
+{
+	enum{ mul = FA + FB, add = FIXED_MAX(FA, FB), div = FA };
+};
+
+/*
+ * @note: the exact intermediate result with F fraction bits
+ */
+template<int F>
+class Fixed_Wide
+{
+public:
+	long long V;
+
+	static Fixed_Wide raw(long long v)
+	{
+		Fixed_Wide r;
+		r.V = v;
+		return r;
+	}
+
+	/* V with F2 >= F fraction bits */
+	template<int F2>
+	long long align() const
+	{
+		return V * Fixed_Pow2<F2 - F>::value;
+	}
+
+	operator double() const
+	{
+		return (double)V * Fixed_Pow2<-F>::scale();
+	}
+
+	Fixed_Wide operator-() const
+	{
+		return raw(-V);
+	}
+
+	Fixed_Wide operator+() const
+	{
+		return *this;
+	}
+};
+
+/*
+ * @note: quantize the integer v with F2 fraction bits to F fraction bits with the mode Q
+ */
+template<int F, ap_q_mode Q, int F2>
+inline long long fixed_quantize(long long v)
+{
+	if( F2 <= F )
+		return v * Fixed_Pow2<(F2 <= F ? F - F2 : 0)>::value;
+
+	const int S = F2 > F ? F2 - F : 1;
+	const long long half = 1LL << (S - 1);
+	const long long low = v & ((1LL << S) - 1);
+	const long long q = v >> S;
+	switch( Q )
+	{
+	case AP_TRN:
+		return q;
+	case AP_TRN_ZERO:
+		return q < 0 && low != 0 ? q + 1 : q;
+	case AP_RND:
+		return low >= half ? q + 1 : q;
+	case AP_RND_ZERO:
+		return low > half || (low == half && q < 0) ? q + 1 : q;
+	case AP_RND_MIN_INF:
+		return low > half ? q + 1 : q;
+	case AP_RND_INF:
+		return low > half || (low == half && q >= 0) ? q + 1 : q;
+	case AP_RND_CONV:
+		return low > half || (low == half && (q & 1)) ? q + 1 : q;
+	default:
+		return q;
+	}
+}
+
+/*
+ * @note: fit the integer v in W bits with the mode O
+ */
+template<int W, ap_o_mode O>
+inline int fixed_overflow(long long v)
+{
+	const long long max = (1LL << (W - 1)) - 1;
+	const long long min = -max - 1;
+	if( v >= min && v <= max )
+		return (int)v;
+
+	switch( O )
+	{
+	case AP_SAT:
+		return (int)(v > max ? max : min);
+	case AP_SAT_ZERO:
+		return 0;
+	case AP_SAT_SYM:
+		return (int)(v > max ? max : -max);
+	default:
+		/* keep the W low bits and extend the sign */
+		return (int)((long long)((unsigned long long)v << (64 - W)) >> (64 - W));
+	}
+}
+
+/*
+ * @note: convert a double to the W bit integer with F fraction bits, the double is quantized exactly
+ */
+template<int W, int F, ap_q_mode Q, ap_o_mode O>
+inline int fixed_from_double(double x)
+{
+	double s = x * Fixed_Pow2<F>::scale();
+	double r;
+	switch( Q )
+	{
+	case AP_TRN:
+		r = floor(s);
+		break;
+	case AP_TRN_ZERO:
+		r = s < 0 ? ceil(s) : floor(s);
+		break;
+	case AP_RND:
+		r = floor(s + 0.5);
+		break;
+	case AP_RND_ZERO:
+		r = s < 0 ? floor(s + 0.5) : ceil(s - 0.5);
+		break;
+	case AP_RND_MIN_INF:
+		r = ceil(s - 0.5);
+		break;
+	case AP_RND_INF:
+		r = s < 0 ? ceil(s - 0.5) : floor(s + 0.5);
+		break;
+	default:
+		r = rint(s);
+		break;
+	}
+	if( r != r )
+		return 0;
+
+	/* the doubles beyond 64 bits are wrapped on the way */
+	const double limit = 4611686018427387904.0;
+	if( r >= limit || r <= -limit )
+	{
+		if( O == AP_WRAP )
+		{
+			double m = (double)(1LL << (W - 1)) * 2;
+			r = fmod(r, m);
+		}
+		else
+			r = r > 0 ? limit : -limit;
+	}
+	return fixed_overflow<W, O>((long long)r);
+}
+
+template<int W, int I, ap_q_mode Q, ap_o_mode O>
+class Fixed
+{
+	/* a negative array size for the unsupported parameters */
+	typedef char check_w[W > 0 && W <= 32 ? 1 : -1];
+	typedef char check_o[O != AP_WRAP_SM ? 1 : -1];
+
+public:
+	enum{ F = W - I };
+	int V;
+
+public:
+	Fixed()
+	{
+	}
+
+	Fixed(const Fixed &x) : V(x.V)
+	{
+	}
+
+	Fixed(const volatile Fixed &x) : V(x.V)
+	{
+	}
+
+	template<int F2>
+	Fixed(const Fixed_Wide<F2> &x) : V(fixed_overflow<W, O>(fixed_quantize<F, Q, F2>(x.V)))
+	{
+	}
+
+	template<int W2, int I2, ap_q_mode Q2, ap_o_mode O2>
+	Fixed(const Fixed<W2, I2, Q2, O2> &x) : V(fixed_overflow<W, O>(fixed_quantize<F, Q, W2 - I2>(x.V)))
+	{
+	}
+
+	Fixed(int x) : V(fixed_overflow<W, O>(fixed_quantize<F, Q, 0>(x)))
+	{
+	}
+
+	Fixed(unsigned int x) : V(fixed_overflow<W, O>(fixed_quantize<F, Q, 0>(x)))
+	{
+	}
+
+	Fixed(long x) : V(fixed_overflow<W, O>(fixed_quantize<F, Q, 0>(x)))
+	{
+	}
+
+	Fixed(long long x) : V(fixed_overflow<W, O>(fixed_quantize<F, Q, 0>(x)))
+	{
+	}
+
+	Fixed(double x) : V(fixed_from_double<W, F, Q, O>(x))
+	{
+	}
+
+	Fixed(float x) : V(fixed_from_double<W, F, Q, O>(x))
+	{
+	}
+
+	Fixed &operator=(const Fixed &x)
+	{
+		V = x.V;
+		return *this;
+	}
+
+	Fixed &operator=(const volatile Fixed &x)
+	{
+		V = x.V;
+		return *this;
+	}
+
+	template<typename T>
+	Fixed &operator=(const T &x)
+	{
+		V = Fixed(x).V;
+		return *this;
+	}
+
+	template<typename T>
+	void operator=(const T &x) volatile
+	{
+		V = Fixed(x).V;
+	}
+
+	void operator=(const Fixed &x) volatile
+	{
+		V = x.V;
+	}
+
+	/* the exact value */
+	Fixed_Wide<F> wide() const
+	{
+		return Fixed_Wide<F>::raw(V);
+	}
+
+	operator double() const
+	{
+		return (double)V * Fixed_Pow2<-F>::scale();
+	}
+
+	operator double() const volatile
+	{
+		return (double)V * Fixed_Pow2<-F>::scale();
+	}
+
+	Fixed_Wide<F> operator-() const
+	{
+		return Fixed_Wide<F>::raw(-(long long)V);
+	}
+
+	Fixed operator+() const
+	{
+		return *this;
+	}
+
+	template<typename T>
+	Fixed &operator+=(const T &x)
+	{
+		return *this = *this + x;
+	}
+
+	template<typename T>
+	Fixed &operator-=(const T &x)
+	{
+		return *this = *this - x;
+	}
+
+	template<typename T>
+	Fixed &operator*=(const T &x)
+	{
+		return *this = *this * x;
+	}
+
+	template<typename T>
+	Fixed &operator/=(const T &x)
+	{
+		return *this = *this / x;
+	}
+};
+
+/*
+ * @note: the operations of two exact values
+ */
+template<int F1, int F2>
+inline Fixed_Wide<Fixed_Frac<F1, F2>::mul> operator*(const Fixed_Wide<F1> &a, const Fixed_Wide<F2> &b)
+{
+	return Fixed_Wide<Fixed_Frac<F1, F2>::mul>::raw(a.V * b.V);
+}
+
+template<int F1, int F2>
+inline Fixed_Wide<Fixed_Frac<F1, F2>::add> operator+(const Fixed_Wide<F1> &a, const Fixed_Wide<F2> &b)
+{
+	const int F = Fixed_Frac<F1, F2>::add;
+	return Fixed_Wide<F>::raw(a.template align<F>() + b.template align<F>());
+}
+
+template<int F1, int F2>
+inline Fixed_Wide<Fixed_Frac<F1, F2>::add> operator-(const Fixed_Wide<F1> &a, const Fixed_Wide<F2> &b)
+{
+	const int F = Fixed_Frac<F1, F2>::add;
+	return Fixed_Wide<F>::raw(a.template align<F>() - b.template align<F>());
+}
+
+/* the quotient keeps the fraction bits of a and is truncated toward zero */
+template<int F1, int F2>
+inline Fixed_Wide<Fixed_Frac<F1, F2>::div> operator/(const Fixed_Wide<F1> &a, const Fixed_Wide<F2> &b)
+{
+	return Fixed_Wide<Fixed_Frac<F1, F2>::div>::raw(a.template align<F1 + FIXED_MAX(F2, 0)>() / b.template align<FIXED_MAX(F2, 0)>());
+}
+
+#define FIXED_REL_OP(REL_OP)																\
+template<int F1, int F2>																	\
+inline bool operator REL_OP(const Fixed_Wide<F1> &a, const Fixed_Wide<F2> &b)				\
+{																							\
+	const int F = Fixed_Frac<F1, F2>::add;													\
+	return a.template align<F>() REL_OP b.template align<F>();								\
+}
+
+FIXED_REL_OP(==)
+FIXED_REL_OP(!=)
+FIXED_REL_OP(>)
+FIXED_REL_OP(>=)
+FIXED_REL_OP(<)
+FIXED_REL_OP(<=)
+
+/*
+ * @note: the C types taken by the operations, the integers are exact values without fraction bits
+ */
+template<typename T, typename R>
+struct Fixed_Int
+{
+};
+
+template<typename T, typename R>
+struct Fixed_Float
+{
+};
+
+#define FIXED_INT_TYPE(C_TYPE)				template<typename R> struct Fixed_Int<C_TYPE, R>{ typedef R type; };
+#define FIXED_FLOAT_TYPE(C_TYPE)			template<typename R> struct Fixed_Float<C_TYPE, R>{ typedef R type; };
+
+FIXED_INT_TYPE(char)
+FIXED_INT_TYPE(signed char)
+FIXED_INT_TYPE(unsigned char)
+FIXED_INT_TYPE(short)
+FIXED_INT_TYPE(unsigned short)
+FIXED_INT_TYPE(int)
+FIXED_INT_TYPE(unsigned int)
+FIXED_INT_TYPE(long)
+FIXED_FLOAT_TYPE(float)
+FIXED_FLOAT_TYPE(double)
+
+/*
+ * @note: the operations between Fixed, Fixed_Wide and the C types, Fixed and the integers are taken as their exact values
+ */
+#define FIXED_BIN_OP(BIN_OP, RTYPE)																				\
+template<int W1, int I1, ap_q_mode Q1, ap_o_mode O1, int W2, int I2, ap_q_mode Q2, ap_o_mode O2>				\
+inline Fixed_Wide<Fixed_Frac<W1 - I1, W2 - I2>::RTYPE> operator BIN_OP(Fixed<W1, I1, Q1, O1> a, Fixed<W2, I2, Q2, O2> b)	\
+{																												\
+	return a.wide() BIN_OP b.wide();																			\
+}																												\
+template<int W1, int I1, ap_q_mode Q1, ap_o_mode O1, int F2>													\
+inline Fixed_Wide<Fixed_Frac<W1 - I1, F2>::RTYPE> operator BIN_OP(Fixed<W1, I1, Q1, O1> a, const Fixed_Wide<F2> &b)	\
+{																												\
+	return a.wide() BIN_OP b;																					\
+}																												\
+template<int F1, int W2, int I2, ap_q_mode Q2, ap_o_mode O2>													\
+inline Fixed_Wide<Fixed_Frac<F1, W2 - I2>::RTYPE> operator BIN_OP(const Fixed_Wide<F1> &a, Fixed<W2, I2, Q2, O2> b)	\
+{																												\
+	return a BIN_OP b.wide();																					\
+}																												\
+template<int W1, int I1, ap_q_mode Q1, ap_o_mode O1, typename T>												\
+inline typename Fixed_Int<T, Fixed_Wide<Fixed_Frac<W1 - I1, 0>::RTYPE> >::type operator BIN_OP(Fixed<W1, I1, Q1, O1> a, T b)	\
+{																												\
+	return a.wide() BIN_OP Fixed_Wide<0>::raw(b);																\
+}																												\
+template<int W2, int I2, ap_q_mode Q2, ap_o_mode O2, typename T>												\
+inline typename Fixed_Int<T, Fixed_Wide<Fixed_Frac<0, W2 - I2>::RTYPE> >::type operator BIN_OP(T a, Fixed<W2, I2, Q2, O2> b)	\
+{																												\
+	return Fixed_Wide<0>::raw(a) BIN_OP b.wide();																\
+}																												\
+template<int F1, typename T>																					\
+inline typename Fixed_Int<T, Fixed_Wide<Fixed_Frac<F1, 0>::RTYPE> >::type operator BIN_OP(const Fixed_Wide<F1> &a, T b)	\
+{																												\
+	return a BIN_OP Fixed_Wide<0>::raw(b);																		\
+}																												\
+template<int F2, typename T>																					\
+inline typename Fixed_Int<T, Fixed_Wide<Fixed_Frac<0, F2>::RTYPE> >::type operator BIN_OP(T a, const Fixed_Wide<F2> &b)	\
+{																												\
+	return Fixed_Wide<0>::raw(a) BIN_OP b;																		\
+}
+
+#define FIXED_FLOAT_OP(BIN_OP, RTYPE)																			\
+template<int W1, int I1, ap_q_mode Q1, ap_o_mode O1, typename T>												\
+inline typename Fixed_Float<T, RTYPE>::type operator BIN_OP(Fixed<W1, I1, Q1, O1> a, T b)						\
+{																												\
+	return (double)a BIN_OP (double)b;																			\
+}																												\
+template<int W2, int I2, ap_q_mode Q2, ap_o_mode O2, typename T>												\
+inline typename Fixed_Float<T, RTYPE>::type operator BIN_OP(T a, Fixed<W2, I2, Q2, O2> b)						\
+{																												\
+	return (double)a BIN_OP (double)b;																			\
+}																												\
+template<int F1, typename T>																					\
+inline typename Fixed_Float<T, RTYPE>::type operator BIN_OP(const Fixed_Wide<F1> &a, T b)						\
+{																												\
+	return (double)a BIN_OP (double)b;																			\
+}																												\
+template<int F2, typename T>																					\
+inline typename Fixed_Float<T, RTYPE>::type operator BIN_OP(T a, const Fixed_Wide<F2> &b)						\
+{																												\
+	return (double)a BIN_OP (double)b;																			\
+}
+
+#define FIXED_REL_BIN_OP(REL_OP)																				\
+template<int W1, int I1, ap_q_mode Q1, ap_o_mode O1, int W2, int I2, ap_q_mode Q2, ap_o_mode O2>				\
+inline bool operator REL_OP(Fixed<W1, I1, Q1, O1> a, Fixed<W2, I2, Q2, O2> b)									\
+{																												\
+	return a.wide() REL_OP b.wide();																			\
+}																												\
+template<int W1, int I1, ap_q_mode Q1, ap_o_mode O1, int F2>													\
+inline bool operator REL_OP(Fixed<W1, I1, Q1, O1> a, const Fixed_Wide<F2> &b)									\
+{																												\
+	return a.wide() REL_OP b;																					\
+}																												\
+template<int F1, int W2, int I2, ap_q_mode Q2, ap_o_mode O2>													\
+inline bool operator REL_OP(const Fixed_Wide<F1> &a, Fixed<W2, I2, Q2, O2> b)									\
+{																												\
+	return a REL_OP b.wide();																					\
+}																												\
+template<int W1, int I1, ap_q_mode Q1, ap_o_mode O1, typename T>												\
+inline typename Fixed_Int<T, bool>::type operator REL_OP(Fixed<W1, I1, Q1, O1> a, T b)							\
+{																												\
+	return a.wide() REL_OP Fixed_Wide<0>::raw(b);																\
+}																												\
+template<int W2, int I2, ap_q_mode Q2, ap_o_mode O2, typename T>												\
+inline typename Fixed_Int<T, bool>::type operator REL_OP(T a, Fixed<W2, I2, Q2, O2> b)							\
+{																												\
+	return Fixed_Wide<0>::raw(a) REL_OP b.wide();																\
+}																												\
+template<int F1, typename T>																					\
+inline typename Fixed_Int<T, bool>::type operator REL_OP(const Fixed_Wide<F1> &a, T b)							\
+{																												\
+	return a REL_OP Fixed_Wide<0>::raw(b);																		\
+}																												\
+template<int F2, typename T>																					\
+inline typename Fixed_Int<T, bool>::type operator REL_OP(T a, const Fixed_Wide<F2> &b)							\
+{																												\
+	return Fixed_Wide<0>::raw(a) REL_OP b;																		\
+}																												\
+FIXED_FLOAT_OP(REL_OP, bool)
+
+FIXED_BIN_OP(*, mul)
+FIXED_BIN_OP(+, add)
+FIXED_BIN_OP(-, add)
+FIXED_BIN_OP(/, div)
+FIXED_FLOAT_OP(*, double)
+FIXED_FLOAT_OP(+, double)
+FIXED_FLOAT_OP(-, double)
+FIXED_FLOAT_OP(/, double)
+
+FIXED_REL_BIN_OP(==)
+FIXED_REL_BIN_OP(!=)
+FIXED_REL_BIN_OP(>)
+FIXED_REL_BIN_OP(>=)
+FIXED_REL_BIN_OP(<)
+FIXED_REL_BIN_OP(<=)
+
+}
+
+#endif
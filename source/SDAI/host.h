@@ -0,0 +1,192 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __HOST_H__
+#define __HOST_H__
+#include "configure.h"
+#include "activation.h"
+
+/*
+ * @note: the host backend is only used in C simulation, the synthesis always sees the HLS loops
+ */
+#if HOST_BACKEND && !defined(__SYNTHESIS__)
+#define HOST_NATIVE		1
+#else
+#define HOST_NATIVE		0
+#endif
+
+#if HOST_NATIVE
+
+namespace SDAI
+{
+/*
+ * @note: the block size of the host GEMM, a HOST_BLOCK_K x HOST_BLOCK_N panel of B stays in the cache
+ * 	while all the rows of A are multiplied with it
+ */
+#define HOST_BLOCK_K		128
+#define HOST_BLOCK_N		512
+
+/*
+ * @note: C[M][N] = A[M][K] * B[K][N] + bias[N], all the matrices are row major with the row stride lda, ldb and ldc
+ * 	the inner loop walks along a row of B and C, so it is contiguous and vectorized by the compiler,
+ * 	four rows of A share every load of B
+ * 	the elements of A are converted to DATA_T and C is the accumulator, as in the HLS loops of the layers
+ */
+template<typename DATA_T, typename A_T, typename B_T, typename C_T>
+void host_gemm(int M, int N, int K, const A_T *A, int lda, const B_T *B, int ldb, const B_T *bias, C_T *C, int ldc)
+{
+	for( int i = 0; i < M; i++)
+	{
+		for( int j = 0; j < N; j++)
+			C[i * ldc + j] = bias ? C_T(bias[j]) : C_T(0);
+	}
+
+	for( int kb = 0; kb < K; kb += HOST_BLOCK_K)
+	{
+		int ke = kb + HOST_BLOCK_K < K ? kb + HOST_BLOCK_K : K;
+		for( int jb = 0; jb < N; jb += HOST_BLOCK_N)
+		{
+			int je = jb + HOST_BLOCK_N < N ? jb + HOST_BLOCK_N : N;
+			int i = 0;
+			for( ; i + 4 <= M; i += 4)
+			{
+				C_T *c0 = &C[(i + 0) * ldc];
+				C_T *c1 = &C[(i + 1) * ldc];
+				C_T *c2 = &C[(i + 2) * ldc];
+				C_T *c3 = &C[(i + 3) * ldc];
+				for( int k = kb; k < ke; k++)
+				{
+					const DATA_T a0 = A[(i + 0) * lda + k];
+					const DATA_T a1 = A[(i + 1) * lda + k];
+					const DATA_T a2 = A[(i + 2) * lda + k];
+					const DATA_T a3 = A[(i + 3) * lda + k];
+					const B_T *b = &B[k * ldb];
+					for( int j = jb; j < je; j++)
+					{
+						B_T v = b[j];
+						c0[j] += a0 * v;
+						c1[j] += a1 * v;
+						c2[j] += a2 * v;
+						c3[j] += a3 * v;
+					}
+				}
+			}
+			for( ; i < M; i++)
+			{
+				C_T *c = &C[i * ldc];
+				for( int k = kb; k < ke; k++)
+				{
+					const DATA_T a = A[i * lda + k];
+					const B_T *b = &B[k * ldb];
+					for( int j = jb; j < je; j++)
+						c[j] += a * b[j];
+				}
+			}
+		}
+	}
+}
+
+/*
+ * @note: y[N] = x[K] * B[K][N] + bias[N], the row major B is read row by row and four rows are accumulated at once,
+ * 	the sizes are template parameters since the small GEMV of the Dense and recurrent layers is dominated by the loop overhead otherwise
+ * 	x is converted to DATA_T and the sum is kept in ACC_T before it is written to y
+ */
+template<typename DATA_T, typename ACC_T, int N, int K, typename X_T, typename W_T, typename BIAS_T, typename Y_T>
+void host_gemv(const X_T *x, const W_T *__restrict B, const BIAS_T *bias, Y_T *__restrict y)
+{
+	ACC_T	acc[N];
+	for( int j = 0; j < N; j++)
+		acc[j] = bias ? ACC_T(bias[j]) : ACC_T(0);
+
+	for( int k = 0; k < K / 4 * 4; k += 4)
+	{
+		const DATA_T x0 = x[k + 0];
+		const DATA_T x1 = x[k + 1];
+		const DATA_T x2 = x[k + 2];
+		const DATA_T x3 = x[k + 3];
+		const W_T *b0 = &B[(k + 0) * N];
+		const W_T *b1 = &B[(k + 1) * N];
+		const W_T *b2 = &B[(k + 2) * N];
+		const W_T *b3 = &B[(k + 3) * N];
+		for( int j = 0; j < N; j++)
+		{
+			/* one MAC at a time, so a fixed point type is quantized in the same order as the HLS loops */
+			ACC_T a = acc[j];
+			a += x0 * b0[j];
+			a += x1 * b1[j];
+			a += x2 * b2[j];
+			a += x3 * b3[j];
+			acc[j] = a;
+		}
+	}
+	for( int k = K / 4 * 4; k < K; k++)
+	{
+		const DATA_T a = x[k];
+		const W_T *b = &B[k * N];
+		for( int j = 0; j < N; j++)
+			acc[j] += a * b[j];
+	}
+
+	for( int j = 0; j < N; j++)
+		y[j] = acc[j];
+}
+
+/*
+ * @note: the host Convolution2D, each output row is lowered by im2col to a OUT_COL x (NB_ROW * NB_COL * INPUT_DIM)
+ * 	matrix and multiplied with the weight seen as a (NB_ROW * NB_COL * INPUT_DIM) x NB_FILTER matrix
+ * 	data is ROW x COL x INPUT_DIM, res is OUT_ROW x OUT_COL x NB_FILTER
+ */
+template<typename DATA_T, typename ACC_T, int NB_FILTER, int NB_ROW, int NB_COL, int ROW, int COL, int INPUT_DIM, ACTIVATION AC_FN,
+		int SUBSAMPLE_ROW, int SUBSAMPLE_COL, int OUT_ROW, int OUT_COL, typename IN_T, typename W_T, typename OUT_T>
+void host_convolution2D(const IN_T *data, const W_T *weight, const W_T *bias, OUT_T *res)
+{
+	const int K = NB_ROW * NB_COL * INPUT_DIM;
+	static DATA_T	col_buf[OUT_COL * K];
+	static ACC_T	acc[OUT_COL * NB_FILTER];
+
+	for( int row = 0; row < OUT_ROW; row++)
+	{
+		/* im2col, the NB_COL x INPUT_DIM elements of one filter row are contiguous in data */
+		for( int col = 0; col < OUT_COL; col++)
+		{
+			for( int m = 0; m < NB_ROW; m++)
+			{
+				const IN_T *src = &data[((row * SUBSAMPLE_ROW + m) * COL + col * SUBSAMPLE_COL) * INPUT_DIM];
+				DATA_T *dst = &col_buf[col * K + m * NB_COL * INPUT_DIM];
+				for( int i = 0; i < NB_COL * INPUT_DIM; i++)
+					dst[i] = src[i];
+			}
+		}
+
+		host_gemm<DATA_T>(OUT_COL, NB_FILTER, K, col_buf, K, weight, NB_FILTER, bias, acc, NB_FILTER);
+
+		OUT_T *out = &res[row * OUT_COL * NB_FILTER];
+		for( int i = 0; i < OUT_COL * NB_FILTER; i++)
+			out[i] = (DATA_T)acc[i];
+		for( int col = 0; col < OUT_COL; col++)
+			activation_apply<AC_FN, NB_FILTER>(&out[col * NB_FILTER]);
+	}
+}
+
+/*
+ * @note: the host Convolution1D, the FILTER_LENGTH x INPUT_DIM window of an output step is contiguous in data,
+ * 	so the input is used as the im2col matrix directly with the row stride SUBSAMPLE_LENGTH * INPUT_DIM
+ * 	data is STEP x INPUT_DIM, res is OUTPUT_DIM x NB_FILTER
+ */
+template<typename DATA_T, typename ACC_T, int NB_FILTER, int FILTER_LENGTH, int INPUT_DIM, int SUBSAMPLE_LENGTH, ACTIVATION AC_FN, int OUTPUT_DIM,
+		typename IN_T, typename W_T, typename OUT_T>
+void host_convolution1D(const IN_T *data, const W_T *weight, const W_T *bias, OUT_T *res)
+{
+	static ACC_T	acc[OUTPUT_DIM * NB_FILTER];
+	host_gemm<DATA_T>(OUTPUT_DIM, NB_FILTER, FILTER_LENGTH * INPUT_DIM, data, SUBSAMPLE_LENGTH * INPUT_DIM, weight, NB_FILTER, bias, acc, NB_FILTER);
+	for( int i = 0; i < OUTPUT_DIM * NB_FILTER; i++)
+		res[i] = (DATA_T)acc[i];
+	for( int i = 0; i < OUTPUT_DIM; i++)
+		activation_apply<AC_FN, NB_FILTER>(&res[i * NB_FILTER]);
+}
+
+}
+
+#endif
+
+#endif
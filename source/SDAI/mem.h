@@ -8,6 +8,7 @@
 #include "configure.h"
 #include <assert.h>
 #include "reshape.h"
+#include "stream.h"
 #if DEBUG
 #include <iostream>
 using namespace std;
@@ -16,23 +17,35 @@ using namespace std;
 namespace SDAI
 {
 
-template< int DIM1>
+template< int DIM1, typename DATA_T = TYPE_T>
 class LineBuffer1D;
 
-template<int DIM1, int DIM2, int SHIFT_ROW>
+template<int DIM1, int DIM2, int SHIFT_ROW, typename DATA_T = TYPE_T>
 class LineBuffer2D;
 
-template <int DIM1, int DIM2, int DIM3, int LineDIM2, int SHIFT_ROW, int SHIFT_COL>
+template <int DIM1, int DIM2, int DIM3, int LineDIM2, int SHIFT_ROW, int SHIFT_COL, typename DATA_T = TYPE_T>
 class WindowBuffer3D;
 
-template<int DIM1, int DIM2, int DIM3, int SHIFT_ROW>
+template<int DIM1, int DIM2, int DIM3, int SHIFT_ROW, typename DATA_T = TYPE_T>
 class LineBuffer3D;
 
+template<int DIM1, int DIM2, int SHIFT_ROW, typename DATA_T = TYPE_T>
+class LineBuffer2D_Circular;
+
+template <int DIM1, int DIM2, int DIM3, int LineDIM2, int SHIFT_ROW, int SHIFT_COL, typename DATA_T = TYPE_T>
+class WindowBuffer3D_Circular;
+
+template<int DIM1, int DIM2, int DIM3, int SHIFT_ROW, typename DATA_T = TYPE_T>
+class LineBuffer3D_Circular;
+
+template<int DIM1, int DIM2, int DIM3, typename DATA_T = TYPE_T>
+class LineBufferRing;
+
 
 /*
  * @note: 1D line buffer
  */
-template< int DIM1>
+template< int DIM1, typename DATA_T>
 class LineBuffer1D
 {
 public:
@@ -40,24 +53,25 @@ public:
 	{
 	}
 public:
-	TYPE_T	val[DIM1];
+	DATA_T	val[DIM1];
 public:
 	/*
 	 * @note: fill the buffer
 	 */
-	void fill(volatile TYPE_T *data)
+	template<typename IN_T>
+	void fill(volatile IN_T *data)
 	{
 #pragma HLS inline
 		for( int i = 0; i < DIM1; i++)
 		{
 #pragma HLS pipeline
-			val[i] = data[i];
+			val[i] = (IN_T)data[i];
 		}
 	}
 	/*
 	 * @note: get the value
 	 */
-	TYPE_T& getval(int dim1)
+	DATA_T& getval(int dim1)
 	{
 #pragma HLS inline
 		return val[dim1];
@@ -68,7 +82,7 @@ public:
 /*
  * @note: define the 3D window buffer
  */
-template <int DIM1, int DIM2, int DIM3, int LineDIM2, int SHIFT_ROW, int SHIFT_COL>
+template <int DIM1, int DIM2, int DIM3, int LineDIM2, int SHIFT_ROW, int SHIFT_COL, typename DATA_T>
 class WindowBuffer3D
 {
 public:
@@ -81,12 +95,12 @@ public:
 	}
 
 public:
-	TYPE_T val[DIM1][DIM2][DIM3];
+	DATA_T val[DIM1][DIM2][DIM3];
 
 	/*
 	 * @note: fill the window buffer
 	 */
-	void fill(LineBuffer3D<DIM1, LineDIM2, DIM3, SHIFT_ROW> &l_buffer, int dim2)
+	void fill(LineBuffer3D<DIM1, LineDIM2, DIM3, SHIFT_ROW, DATA_T> &l_buffer, int dim2)
 	{
 		for( int i = 0; i < DIM1; i++)
 		{
@@ -103,7 +117,7 @@ public:
 	/*
 	 * @note: get value function
 	 */
-	TYPE_T& getval(int dim1, int dim2, int dim3)
+	DATA_T& getval(int dim1, int dim2, int dim3)
 	{
 #pragma HLS inline
 		return val[dim1][dim2][dim3];
@@ -129,19 +143,19 @@ public:
 	}
 
 	/*
-	 * @note: insert data from the right side
+	 * @note: insert data from the right side, dim2 is the first new column in the line buffer
 	 */
-	void insert_right(LineBuffer3D<DIM1, LineDIM2, DIM3, SHIFT_ROW> &l_buffer, int dim2)
+	void insert_right(LineBuffer3D<DIM1, LineDIM2, DIM3, SHIFT_ROW, DATA_T> &l_buffer, int dim2)
 	{
 #pragma HLS inline
 
 		for( int i = 0; i < DIM1; i++)
 		{
-			for( int j = SHIFT_COL - 1; j >= 0; j--)
+			for( int j = 0; j < SHIFT_COL; j++)
 			{
 				for( int k = 0; k < DIM3; k++)
 				{
-					val[i][DIM2 - 1 - j][k] = l_buffer.getval(i, dim2 + j, k);
+					val[i][DIM2 - SHIFT_COL + j][k] = l_buffer.getval(i, dim2 + j, k);
 				}
 			}
 		}
@@ -151,7 +165,7 @@ public:
 /*
  * @note: define the 2D stream line buffer
  */
-template<int DIM1, int DIM2, int SHIFT_ROW>
+template<int DIM1, int DIM2, int SHIFT_ROW, typename DATA_T>
 class LineBuffer2D
 {
 public:
@@ -163,21 +177,22 @@ public:
 #pragma HLS dependence variable=val intra false
 	}
 public:
-	TYPE_T val[DIM1][DIM2];
+	DATA_T val[DIM1][DIM2];
 
 public:
 
 	/*
 	 * @note: fill the arrays
 	 */
-	void fill(volatile TYPE_T *data)
+	template<typename IN_T>
+	void fill(volatile IN_T *data)
 	{
 		for(int i = 0; i < DIM1; i++)
 		{
 #pragma HLS pipeline
 			for(int j = 0; j < DIM2; j++)
 			{
-				val[i][j] = data[i * DIM2  + j];
+				val[i][j] = (IN_T)data[i * DIM2  + j];
 			}
 		}
 	}
@@ -185,14 +200,15 @@ public:
 	/*
 	 * @note: fill the new line
 	 */
-	void fill_line(volatile TYPE_T *data)
+	template<typename IN_T>
+	void fill_line(volatile IN_T *data)
 	{
 		for( int i = SHIFT_ROW - 1; i >= 0; i--)
 		{
 #pragma HLS pipeline
 			for( int j = 0; j < DIM2; j++)
 			{
-				val[DIM1 - 1 - i][j] = data[(SHIFT_ROW - 1 - i) * DIM2  + j];
+				val[DIM1 - 1 - i][j] = (IN_T)data[(SHIFT_ROW - 1 - i) * DIM2  + j];
 			}
 		}
 	}
@@ -218,7 +234,7 @@ public:
 	/*
 	 * @note: get the value
 	 */
-	TYPE_T& getval(int dim1, int dim2)
+	DATA_T& getval(int dim1, int dim2)
 	{
 #pragma HLS inline
 		return val[dim1][dim2];
@@ -230,7 +246,7 @@ public:
 /*
  * @note: define the 3D stream line buffer
  */
-template<int DIM1, int DIM2, int DIM3, int SHIFT_ROW>
+template<int DIM1, int DIM2, int DIM3, int SHIFT_ROW, typename DATA_T>
 class LineBuffer3D
 {
 public:
@@ -242,14 +258,15 @@ public:
 #pragma HLS dependence variable=val intra false
 	}
 public:
-	TYPE_T val[DIM1][DIM2][DIM3];
+	DATA_T val[DIM1][DIM2][DIM3];
 
 public:
 
 	/*
 	 * @note: fill the arrays
 	 */
-	void fill(volatile TYPE_T *data)
+	template<typename IN_T>
+	void fill(volatile IN_T *data)
 	{
 		for(int i = 0; i < DIM1; i++)
 		{
@@ -258,7 +275,7 @@ public:
 				for( int k = 0; k < DIM3; k++)
 				{
 #pragma HLS pipeline
-					val[i][j][k] = data[i * DIM2 * DIM3 + j * DIM3 + k];
+					val[i][j][k] = (IN_T)data[i * DIM2 * DIM3 + j * DIM3 + k];
 				}
 			}
 		}
@@ -267,7 +284,8 @@ public:
 	/*
 	 * @note: fill the new line
 	 */
-	void fill_line(volatile TYPE_T *data)
+	template<typename IN_T>
+	void fill_line(volatile IN_T *data)
 	{
 #pragma HLS inline
 
@@ -278,7 +296,7 @@ public:
 				for( int k = 0; k < DIM3; k++)
 				{
 #pragma HLS pipeline
-					val[DIM1 - 1 - i][j][k] = data[(SHIFT_ROW - 1 - i) * DIM2 * DIM3 + j * DIM3 + k];
+					val[DIM1 - 1 - i][j][k] = (IN_T)data[(SHIFT_ROW - 1 - i) * DIM2 * DIM3 + j * DIM3 + k];
 				}
 			}
 		}
@@ -308,7 +326,7 @@ public:
 	/*
 	 * @note: get the value
 	 */
-	TYPE_T& getval(int dim1, int dim2, int dim3)
+	DATA_T& getval(int dim1, int dim2, int dim3)
 	{
 #pragma HLS inline
 		return val[dim1][dim2][dim3];
@@ -316,6 +334,400 @@ public:
 
 };
 
+
+/*
+ * @note: define the 2D circular line buffer, it has the same interface as LineBuffer2D,
+ * 	but shift_up only rotates the head index and fill_line overwrites the oldest lines in place
+ */
+template<int DIM1, int DIM2, int SHIFT_ROW, typename DATA_T>
+class LineBuffer2D_Circular
+{
+public:
+	LineBuffer2D_Circular()
+	{
+		assert(DIM1 >= SHIFT_ROW);
+#pragma HLS array_reshape variable=val dim=1
+#pragma HLS dependence variable=val inter false
+#pragma HLS dependence variable=val intra false
+		head = 0;
+	}
+public:
+	DATA_T val[DIM1][DIM2];
+	/* the physical line of the logical line 0 */
+	int head;
+
+public:
+
+	/*
+	 * @note: fill the arrays
+	 */
+	template<typename IN_T>
+	void fill(volatile IN_T *data)
+	{
+		head = 0;
+		for(int i = 0; i < DIM1; i++)
+		{
+#pragma HLS pipeline
+			for(int j = 0; j < DIM2; j++)
+			{
+				val[i][j] = (IN_T)data[i * DIM2  + j];
+			}
+		}
+	}
+
+	/*
+	 * @note: fill the new line
+	 */
+	template<typename IN_T>
+	void fill_line(volatile IN_T *data)
+	{
+		for( int i = 0; i < SHIFT_ROW; i++)
+		{
+#pragma HLS pipeline
+			int line = line_index(DIM1 - SHIFT_ROW + i);
+			for( int j = 0; j < DIM2; j++)
+			{
+				val[line][j] = (IN_T)data[i * DIM2  + j];
+			}
+		}
+	}
+
+
+	/*
+	 * @note: shift up function, only the head index is moved
+	 */
+	void shift_up()
+	{
+#pragma HLS inline
+		head = line_index(SHIFT_ROW);
+	}
+
+
+	/*
+	 * @note: get the value
+	 */
+	DATA_T& getval(int dim1, int dim2)
+	{
+#pragma HLS inline
+		return val[line_index(dim1)][dim2];
+	}
+
+private:
+	/*
+	 * @note: map the logical line to the physical line
+	 */
+	int line_index(int dim1)
+	{
+#pragma HLS inline
+		int line = head + dim1;
+		return line < DIM1 ? line : line - DIM1;
+	}
+};
+
+
+/*
+ * @note: define the 3D circular line buffer, it has the same interface as LineBuffer3D,
+ * 	but shift_up only rotates the head index and fill_line overwrites the oldest lines in place
+ */
+template<int DIM1, int DIM2, int DIM3, int SHIFT_ROW, typename DATA_T>
+class LineBuffer3D_Circular
+{
+public:
+	LineBuffer3D_Circular()
+	{
+		assert(DIM1 >= SHIFT_ROW);
+#pragma HLS array_reshape variable=val dim=1
+#pragma HLS dependence variable=val inter false
+#pragma HLS dependence variable=val intra false
+		head = 0;
+	}
+public:
+	DATA_T val[DIM1][DIM2][DIM3];
+	/* the physical line of the logical line 0 */
+	int head;
+
+public:
+
+	/*
+	 * @note: fill the arrays
+	 */
+	template<typename IN_T>
+	void fill(volatile IN_T *data)
+	{
+		head = 0;
+		for(int i = 0; i < DIM1; i++)
+		{
+			for(int j = 0; j < DIM2; j++)
+			{
+				for( int k = 0; k < DIM3; k++)
+				{
+#pragma HLS pipeline
+					val[i][j][k] = (IN_T)data[i * DIM2 * DIM3 + j * DIM3 + k];
+				}
+			}
+		}
+	}
+
+	/*
+	 * @note: fill the new line
+	 */
+	template<typename IN_T>
+	void fill_line(volatile IN_T *data)
+	{
+#pragma HLS inline
+
+		for( int i = 0; i < SHIFT_ROW; i++)
+		{
+			int line = line_index(DIM1 - SHIFT_ROW + i);
+			for( int j = 0; j < DIM2; j++)
+			{
+				for( int k = 0; k < DIM3; k++)
+				{
+#pragma HLS pipeline
+					val[line][j][k] = (IN_T)data[i * DIM2 * DIM3 + j * DIM3 + k];
+				}
+			}
+		}
+	}
+
+
+	/*
+	 * @note: shift up function, only the head index is moved
+	 */
+	void shift_up()
+	{
+#pragma HLS inline
+		head = line_index(SHIFT_ROW);
+	}
+
+
+	/*
+	 * @note: get the value
+	 */
+	DATA_T& getval(int dim1, int dim2, int dim3)
+	{
+#pragma HLS inline
+		return val[line_index(dim1)][dim2][dim3];
+	}
+
+private:
+	/*
+	 * @note: map the logical line to the physical line
+	 */
+	int line_index(int dim1)
+	{
+#pragma HLS inline
+		int line = head + dim1;
+		return line < DIM1 ? line : line - DIM1;
+	}
+};
+
+
+/*
+ * @note: define the 3D circular window buffer, it has the same interface as WindowBuffer3D,
+ * 	but shift_left only rotates the head column and insert_right overwrites the oldest columns in place
+ */
+template <int DIM1, int DIM2, int DIM3, int LineDIM2, int SHIFT_ROW, int SHIFT_COL, typename DATA_T>
+class WindowBuffer3D_Circular
+{
+public:
+	WindowBuffer3D_Circular()
+	{
+		assert(DIM2 >= SHIFT_COL);
+#pragma HLS ARRAY_PARTITION variable=val dim=1 complete
+#pragma HLS ARRAY_PARTITION variable=val dim=2 complete
+#pragma HLS ARRAY_PARTITION variable=val dim=3 complete
+		head = 0;
+	}
+
+public:
+	DATA_T val[DIM1][DIM2][DIM3];
+	/* the physical column of the logical column 0 */
+	int head;
+
+	/*
+	 * @note: fill the window buffer
+	 */
+	void fill(LineBuffer3D_Circular<DIM1, LineDIM2, DIM3, SHIFT_ROW, DATA_T> &l_buffer, int dim2)
+	{
+		head = 0;
+		for( int i = 0; i < DIM1; i++)
+		{
+			for( int j = 0; j < DIM2; j++)
+			{
+				for( int k = 0; k < DIM3; k++)
+				{
+					val[i][j][k]= l_buffer.getval(i, j + dim2, k);
+				}
+			}
+		}
+	}
+
+	/*
+	 * @note: get value function
+	 */
+	DATA_T& getval(int dim1, int dim2, int dim3)
+	{
+#pragma HLS inline
+		return val[dim1][col_index(dim2)][dim3];
+	}
+
+	/*
+	 * @note: shift left function, only the head column is moved
+	 */
+	void shift_left()
+	{
+#pragma HLS inline
+		head = col_index(SHIFT_COL);
+	}
+
+	/*
+	 * @note: insert data from the right side, dim2 is the first new column in the line buffer
+	 */
+	void insert_right(LineBuffer3D_Circular<DIM1, LineDIM2, DIM3, SHIFT_ROW, DATA_T> &l_buffer, int dim2)
+	{
+#pragma HLS inline
+
+		for( int i = 0; i < DIM1; i++)
+		{
+			for( int j = 0; j < SHIFT_COL; j++)
+			{
+				int col = col_index(DIM2 - SHIFT_COL + j);
+				for( int k = 0; k < DIM3; k++)
+				{
+					val[i][col][k] = l_buffer.getval(i, dim2 + j, k);
+				}
+			}
+		}
+	}
+
+private:
+	/*
+	 * @note: map the logical column to the physical column
+	 */
+	int col_index(int dim2)
+	{
+#pragma HLS inline
+		int col = head + dim2;
+		return col < DIM2 ? col : col - DIM2;
+	}
+};
+
+/*
+ * @note: define the ring line buffer of the OPT_STREAM and FIFO paths, the input line y is kept in the slot y % DIM1,
+ * 	advance moves the window to the lines first ... first + DIM1 - 1 and only reads the lines that are not in the buffer yet,
+ * 	so each input element is read once, the line m of the window is getval(m, dim2, dim3)
+ */
+template<int DIM1, int DIM2, int DIM3, typename DATA_T>
+class LineBufferRing
+{
+public:
+	LineBufferRing()
+	{
+#pragma HLS ARRAY_PARTITION variable=val dim=1 complete
+		head = 0;
+		nb_read = 0;
+	}
+public:
+	DATA_T val[DIM1][DIM2][DIM3];
+	/* the slot of the first line of the window */
+	int head;
+	/* the number of input lines already read */
+	int nb_read;
+
+public:
+	/*
+	 * @note: move the window to the line first, data is the whole input on the AXI master,
+	 * 	the lines from nb_line on are out of the input and are not read
+	 */
+	template<typename IN_T>
+	void advance(volatile IN_T *data, int first, int nb_line)
+	{
+		head = first % DIM1;
+		for( int m = 0; m < DIM1; m++)
+		{
+			int y = first + m;
+			if( y >= nb_read && y < nb_line )
+			{
+				int slot = line_index(m);
+				for( int x = 0; x < DIM2; x++)
+				{
+					for( int v = 0; v < DIM3; v++)
+					{
+#pragma HLS pipeline
+						val[slot][x][v] = (IN_T)data[y * DIM2 * DIM3 + x * DIM3 + v];
+					}
+				}
+			}
+		}
+		nb_read = first + DIM1;
+	}
+
+	/*
+	 * @note: move the window to the line first, the input lines are read in order from the FIFO
+	 * 	and the lines before first that are in no window are dropped
+	 */
+	template<typename IN_T>
+	void advance(hls::stream<IN_T> &in, int first, int nb_line)
+	{
+		drop(in, first);
+		head = first % DIM1;
+		for( int m = 0; m < DIM1; m++)
+		{
+			int y = first + m;
+			if( y >= nb_read && y < nb_line )
+			{
+				int slot = line_index(m);
+				for( int x = 0; x < DIM2; x++)
+				{
+					for( int v = 0; v < DIM3; v++)
+					{
+#pragma HLS pipeline
+						val[slot][x][v] = in.read();
+					}
+				}
+			}
+		}
+		nb_read = first + DIM1;
+	}
+
+	/*
+	 * @note: drop the input lines up to nb_line, it is called after the last window to empty the FIFO
+	 */
+	template<typename IN_T>
+	void drop(hls::stream<IN_T> &in, int nb_line)
+	{
+		for( ; nb_read < nb_line; nb_read++)
+		{
+			for( int x = 0; x < DIM2 * DIM3; x++)
+			{
+#pragma HLS pipeline
+				in.read();
+			}
+		}
+	}
+
+	/*
+	 * @note: get the value of the line m of the window
+	 */
+	DATA_T& getval(int m, int dim2, int dim3)
+	{
+#pragma HLS inline
+		return val[line_index(m)][dim2][dim3];
+	}
+
+private:
+	/*
+	 * @note: map the line of the window to the slot
+	 */
+	int line_index(int m)
+	{
+#pragma HLS inline
+		int line = head + m;
+		return line < DIM1 ? line : line - DIM1;
+	}
+};
+
 }
 
 #endif
@@ -6,6 +6,8 @@
 #define __POOLING_H__
 #include <assert.h>
 #include "configure.h"
+#include "stream.h"
+#include "mem.h"
 
 #if DEBUG
 #include <iostream>
@@ -23,7 +25,7 @@ namespace SDAI
  * 			DIM2 is the second Dimension size for the input shape
  * 			OUTPUT_DIM is the first Dimension size for the output shape
  */
-template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH)>
+template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH), typename DATA_T = TYPE_T>
 class MaxPooling1D
 {
 public:
@@ -37,15 +39,16 @@ public:
 		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
 #endif
 	};
-	TYPE_T	res[OUTPUT_DIM][DIM2];
+	DATA_T	res[OUTPUT_DIM][DIM2];
 
 public:
 	/*
 	 * @note: feedforward function
 	 */
-	void feedforward(TYPE_T data[DIM1][DIM2])
+	template<typename IN_T>
+	void feedforward(IN_T data[DIM1][DIM2])
 	{
-		TYPE_T max;
+		DATA_T max;
 		for( int i = 0; i < OUTPUT_DIM; i++)
 		{
 #if POOLING1D_PERF_MODE == PERF_HIGH
@@ -63,7 +66,7 @@ public:
 #if POOLING1D_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-					TYPE_T tmp = data[i * POOL_LENGTH + k][j];
+					DATA_T tmp = data[i * POOL_LENGTH + k][j];
 					if( tmp > max)
 						max = tmp;
 				}
@@ -72,12 +75,51 @@ public:
 		}
 	}
 
+
+	/*
+	 * @note: feedforward function with FIFO channels, the DIM1 x DIM2 input is read once in order and
+	 * 	each pooled step is written after its last input step
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		/* the running maximum of the current pooled step */
+		DATA_T	pool[DIM2];
+
+		for( int i = 0; i < DIM1; i++)
+		{
+			for( int j = 0; j < DIM2; j++)
+			{
+#pragma HLS pipeline
+				DATA_T v = in.read();
+
+				/* the input out of the pooling windows is dropped */
+				if( i < OUTPUT_DIM * POOL_LENGTH )
+				{
+					if( i % POOL_LENGTH == 0 )
+						pool[j] = v;
+					else
+						pool[j] = v > pool[j] ? v : pool[j];
+				}
+			}
+
+			/* write the pooled step */
+			if( i < OUTPUT_DIM * POOL_LENGTH && i % POOL_LENGTH == POOL_LENGTH - 1 )
+			{
+				for( int j = 0; j < DIM2; j++)
+				{
+#pragma HLS pipeline
+					out.write(pool[j]);
+				}
+			}
+		}
+	}
 };
 
 /*
  * @note:  stream-based MaxPooling1D
  */
-template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH)>
+template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH), typename DATA_T = TYPE_T>
 class MaxPooling1D_Stream
 {
 public:
@@ -96,18 +138,23 @@ public:
 	/*
 	 * @note: feedforward function
 	 */
-	void feedforward(volatile TYPE_T *data, volatile TYPE_T *res)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res)
 	{
 #if POOLING1D_OPT_MODE == OPT_BUFFER
 		/* define the line buffer and window buffer */
-		LineBuffer2D<POOL_LENGTH, DIM2, POOL_LENGTH>				l_buffer;
+#if OPT_BUFFER_CIRCULAR
+		LineBuffer2D_Circular<POOL_LENGTH, DIM2, POOL_LENGTH, DATA_T>	l_buffer;
+#else
+		LineBuffer2D<POOL_LENGTH, DIM2, POOL_LENGTH, DATA_T>			l_buffer;
+#endif
 
 		/* fill the line buffer and window buffer */
 		l_buffer.fill( data );
 
 #elif POOLING1D_OPT_MODE == OPT_MEM
 		/* define a local BRAM*/
-		Reshape_Stream_2D<POOL_LENGTH, DIM2>						stream;
+		Reshape_Stream_2D<POOL_LENGTH, DIM2, ORDER_X, DATA_T>		stream;
 #pragma HLS ARRAY_PARTITION variable=stream.res dim=1 complete
 #endif
 		for( int i = 0; i < OUTPUT_DIM; i++)
@@ -136,12 +183,12 @@ public:
 
 				/* calculate the maximum value in the POOL_LENGTH */
 #if POOLING1D_OPT_MODE == OPT_BUFFER
-				TYPE_T max = l_buffer.getval(0, j);
+				DATA_T max = l_buffer.getval(0, j);
 #elif POOLING1D_OPT_MODE == OPT_MEM
-				TYPE_T max = stream.res[0][j];
+				DATA_T max = stream.res[0][j];
 
 #else
-				TYPE_T max = data[(i * POOL_LENGTH) * DIM2 + j];
+				DATA_T max = (IN_T)data[(i * POOL_LENGTH) * DIM2 + j];
 #endif
 
 				for(int k = 1; k < POOL_LENGTH; k++)
@@ -151,11 +198,11 @@ public:
 #endif
 
 #if POOLING1D_OPT_MODE == OPT_BUFFER
-					TYPE_T val = l_buffer.getval(k, j);
+					DATA_T val = l_buffer.getval(k, j);
 #elif POOLING1D_OPT_MODE == OPT_MEM
-					TYPE_T val = stream.res[k][j];
+					DATA_T val = stream.res[k][j];
 #else
-					TYPE_T val = data[(i * POOL_LENGTH + k) * DIM2 + j];
+					DATA_T val = (IN_T)data[(i * POOL_LENGTH + k) * DIM2 + j];
 #endif
 					if( val > max)
 						max = val;
@@ -174,7 +221,7 @@ public:
  * 			DIM2 is the second Dimension size for the input shape
  * 			OUTPUT_DIM is the first Dimension size for the output shape
  */
-template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH)>
+template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH), typename DATA_T = TYPE_T, typename ACC_T = TYPE_T>
 class AveragePooling1D
 {
 public:
@@ -187,10 +234,11 @@ public:
 		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
 #endif
 	};
-	TYPE_T res[OUTPUT_DIM][DIM2];
+	DATA_T res[OUTPUT_DIM][DIM2];
 
 public:
-	void feedforward(TYPE_T data[DIM1][DIM2])
+	template<typename IN_T>
+	void feedforward(IN_T data[DIM1][DIM2])
 	{
 		for( int i = 0; i < OUTPUT_DIM; i++)
 		{
@@ -203,23 +251,62 @@ public:
 #pragma HLS pipeline
 #endif
 				/* calculate the average value in the POOL_LENGTH */
-				TYPE_T sum = 0;
+				ACC_T sum = 0;
 				for( int k = 0; k < POOL_LENGTH; k++)
 				{
 #if POOLING1D_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-					sum += data[i * POOL_LENGTH + k ][j];
+					sum += (DATA_T)data[i * POOL_LENGTH + k ][j];
 				}
 
-				res[i][j] = sum/POOL_LENGTH;
+				res[i][j] = (DATA_T)(sum/POOL_LENGTH);
 			}
 		}
 	}
 
+
+	/*
+	 * @note: feedforward function with FIFO channels, the DIM1 x DIM2 input is read once in order and
+	 * 	each pooled step is written after its last input step
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		/* the running sum of the current pooled step */
+		ACC_T	pool[DIM2];
+
+		for( int i = 0; i < DIM1; i++)
+		{
+			for( int j = 0; j < DIM2; j++)
+			{
+#pragma HLS pipeline
+				DATA_T v = in.read();
+
+				/* the input out of the pooling windows is dropped */
+				if( i < OUTPUT_DIM * POOL_LENGTH )
+				{
+					if( i % POOL_LENGTH == 0 )
+						pool[j] = v;
+					else
+						pool[j] += v;
+				}
+			}
+
+			/* write the pooled step */
+			if( i < OUTPUT_DIM * POOL_LENGTH && i % POOL_LENGTH == POOL_LENGTH - 1 )
+			{
+				for( int j = 0; j < DIM2; j++)
+				{
+#pragma HLS pipeline
+					out.write((DATA_T)(pool[j]/POOL_LENGTH));
+				}
+			}
+		}
+	}
 };
 
-template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH)>
+template<int POOL_LENGTH, int DIM1, int DIM2, int OUTPUT_DIM = (DIM1/POOL_LENGTH), typename DATA_T = TYPE_T, typename ACC_T = TYPE_T>
 class AveragePooling1D_Stream
 {
 public:
@@ -237,18 +324,23 @@ public:
 	/*
 	 * @note: the feed forward function
 	 */
-	void feedforward(volatile TYPE_T *data, volatile TYPE_T *res)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res)
 	{
 #if POOLING1D_OPT_MODE == OPT_BUFFER
 		/* define the line buffer and window buffer */
-		LineBuffer2D<POOL_LENGTH, DIM2, POOL_LENGTH>				l_buffer;
+#if OPT_BUFFER_CIRCULAR
+		LineBuffer2D_Circular<POOL_LENGTH, DIM2, POOL_LENGTH, DATA_T>	l_buffer;
+#else
+		LineBuffer2D<POOL_LENGTH, DIM2, POOL_LENGTH, DATA_T>			l_buffer;
+#endif
 
 		/* fill the line buffer and window buffer */
 		l_buffer.fill( data );
 
 #elif POOLING1D_OPT_MODE == OPT_MEM
 		/* define a local BRAM*/
-		Reshape_Stream_2D<POOL_LENGTH, DIM2>						stream;
+		Reshape_Stream_2D<POOL_LENGTH, DIM2, ORDER_X, DATA_T>		stream;
 #endif
 
 		for( int i = 0; i < OUTPUT_DIM; i++)
@@ -275,7 +367,7 @@ public:
 #pragma HLS pipeline
 #endif
 				/* calculate the average value in the POOL_LENGTH */
-				TYPE_T sum = 0;
+				ACC_T sum = 0;
 				for( int k = 0; k < POOL_LENGTH; k++)
 				{
 #if POOLING1D_PERF_MODE == PERF_LOW
@@ -283,16 +375,16 @@ public:
 #endif
 
 #if POOLING1D_OPT_MODE == OPT_BUFFER
-					TYPE_T val = l_buffer.getval(k, j);
+					DATA_T val = l_buffer.getval(k, j);
 #elif POOLING1D_OPT_MODE == OPT_MEM
-					TYPE_T val = stream.res[k][j];
+					DATA_T val = stream.res[k][j];
 #else
-					TYPE_T val = data[(i * POOL_LENGTH + k) * DIM2 + j];
+					DATA_T val = (IN_T)data[(i * POOL_LENGTH + k) * DIM2 + j];
 #endif
 					sum += val;
 				}
 				/* save the result */
-				res[i * DIM2 + j] = sum/POOL_LENGTH;
+				res[i * DIM2 + j] = (DATA_T)(sum/POOL_LENGTH);
 			}
 		}
 	}
@@ -5,8 +5,11 @@
 #ifndef __POOLING2D_H__
 #define __POOLING2D_H__
 #include "configure.h"
+#include "stream.h"
 #include <assert.h>
 #include "reshape.h"
+#include "mem.h"
+#include "binary.h"
 
 #if 1
 #include <iostream>
@@ -19,7 +22,7 @@ namespace SDAI
 /*
  * @note: 2D Maximum Pooling layer, normally used after Convolution2D layer
  */
-template<int ROW, int COL, int NB, int POOL_ROW = 2, int POOL_COL = 2, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL>
+template<int ROW, int COL, int NB, int POOL_ROW = 2, int POOL_COL = 2, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL, typename DATA_T = TYPE_T>
 class MaxPooling2D
 {
 public:
@@ -39,13 +42,14 @@ public:
 #endif
 	}
 public:
-	TYPE_T res[OUT_ROW][OUT_COL][NB];
+	DATA_T res[OUT_ROW][OUT_COL][NB];
 
 public:
 	/*
 	 * @note: the input data is ROW x COL x NB 3D array
 	 */
-	void feedforward(TYPE_T data[ROW][COL][NB])
+	template<typename IN_T>
+	void feedforward(IN_T data[ROW][COL][NB])
 	{
 		MAXPOOLING2D: for (int row = 0; row < OUT_ROW; row++)
 		{
@@ -63,7 +67,7 @@ public:
 #pragma HLS pipeline
 #endif
 					/* calculate the maximum value in the local window*/
-					TYPE_T max = data[row * POOL_ROW][col * POOL_COL][k];
+					DATA_T max = data[row * POOL_ROW][col * POOL_COL][k];
 					for (int i = 0; i < POOL_ROW; i++)
 					{
 						for (int j = 0; j < POOL_COL; j++)
@@ -71,7 +75,7 @@ public:
 #if POOLING2D_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-							TYPE_T v = data[row * POOL_ROW + i][col * POOL_COL + j][k];
+							DATA_T v = data[row * POOL_ROW + i][col * POOL_COL + j][k];
 							if (v > max)
 								max = v;
 						}
@@ -81,12 +85,58 @@ public:
 			}
 		}
 	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, the ROW x COL x NB input is read once in order and
+	 * 	each pooled row is written after its last input row
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		/* the running maximum of the current pooled row */
+		DATA_T	pool[OUT_COL][NB];
+
+		for( int row = 0; row < ROW; row++)
+		{
+			for( int col = 0; col < COL; col++)
+			{
+				for( int k = 0; k < NB; k++)
+				{
+#pragma HLS pipeline
+					DATA_T v = in.read();
+
+					/* the input out of the pooling windows is dropped */
+					if( row < OUT_ROW * POOL_ROW && col < OUT_COL * POOL_COL )
+					{
+						int p = col / POOL_COL;
+						if( row % POOL_ROW == 0 && col % POOL_COL == 0 )
+							pool[p][k] = v;
+						else
+							pool[p][k] = v > pool[p][k] ? v : pool[p][k];
+					}
+				}
+			}
+
+			/* write the pooled row */
+			if( row < OUT_ROW * POOL_ROW && row % POOL_ROW == POOL_ROW - 1 )
+			{
+				for( int col = 0; col < OUT_COL; col++)
+				{
+					for( int k = 0; k < NB; k++)
+					{
+#pragma HLS pipeline
+						out.write(pool[col][k]);
+					}
+				}
+			}
+		}
+	}
 };
 
 /*
  * @note: 2D Maximum Pooling layer, normally used after Convolution2D layer
  */
-template<int ROW, int COL, int NB, int POOL_ROW = 2, int POOL_COL = 2, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL>
+template<int ROW, int COL, int NB, int POOL_ROW = 2, int POOL_COL = 2, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL, typename DATA_T = TYPE_T>
 class MaxPooling2D_Stream
 {
 public:
@@ -111,13 +161,19 @@ public:
 	/*
 	 * @note: the input data is ROW x COL x NB 3D array
 	 */
-	void feedforward(volatile TYPE_T *data, volatile TYPE_T *res)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res)
 	{
 
 #if POOLING2D_OPT_MODE == OPT_BUFFER
 		/* define a 3D LineBuffer */
-		LineBuffer3D<POOL_ROW, COL, NB, POOL_ROW>								l_buffer;
-		WindowBuffer3D<POOL_ROW, POOL_COL, NB, COL, POOL_ROW, POOL_COL>			w_buffer;
+#if OPT_BUFFER_CIRCULAR
+		LineBuffer3D_Circular<POOL_ROW, COL, NB, POOL_ROW, DATA_T>						l_buffer;
+		WindowBuffer3D_Circular<POOL_ROW, POOL_COL, NB, COL, POOL_ROW, POOL_COL, DATA_T>	w_buffer;
+#else
+		LineBuffer3D<POOL_ROW, COL, NB, POOL_ROW, DATA_T>						l_buffer;
+		WindowBuffer3D<POOL_ROW, POOL_COL, NB, COL, POOL_ROW, POOL_COL, DATA_T>	w_buffer;
+#endif
 
 		/* fill the line buffer and window buffer */
 		l_buffer.fill( data );
@@ -125,7 +181,7 @@ public:
 
 #elif POOLING2D_OPT_MODE == OPT_MEM
 		/* define a local BRAM to store part of the data */
-		Reshape_Stream_3D<POOL_ROW, COL, NB>	stream;
+		Reshape_Stream_3D<POOL_ROW, COL, NB, ORDER_X, DATA_T>	stream;
 
 #endif
 
@@ -172,11 +228,11 @@ public:
 					/* calculate the maximum value in the local window*/
 
 #if POOLING2D_OPT_MODE == OPT_BUFFER
-					TYPE_T max = w_buffer.getval(0, 0, k);
+					DATA_T max = w_buffer.getval(0, 0, k);
 #elif POOLING2D_OPT_MODE == OPT_MEM
-					TYPE_T max = stream.res[0][col * POOL_COL][k];
+					DATA_T max = stream.res[0][col * POOL_COL][k];
 #else
-					TYPE_T max = data[(row * POOL_ROW ) * COL * NB + (col * POOL_COL) * NB + k];
+					DATA_T max = (IN_T)data[(row * POOL_ROW ) * COL * NB + (col * POOL_COL) * NB + k];
 #endif
 					for (int i = 0; i < POOL_ROW; i++)
 					{
@@ -187,11 +243,11 @@ public:
 #endif
 
 #if POOLING2D_OPT_MODE == OPT_BUFFER
-							TYPE_T v = w_buffer.getval(i, j, k);
+							DATA_T v = w_buffer.getval(i, j, k);
 #elif POOLING2D_OPT_MODE == OPT_MEM
-							TYPE_T v = stream.res[i][col * POOL_COL + j][k];
+							DATA_T v = stream.res[i][col * POOL_COL + j][k];
 #else
-							TYPE_T v = data[(row * POOL_ROW + i) * COL * NB + (col * POOL_COL + j) * NB + k];
+							DATA_T v = (IN_T)data[(row * POOL_ROW + i) * COL * NB + (col * POOL_COL + j) * NB + k];
 #endif
 							if (v > max)
 								max = v;
@@ -205,10 +261,70 @@ public:
 };
 
 
+/*
+ * @note: 2D Maximum Pooling layer of the packed +1 and -1 values of Convolution2D_Binary, the maximum is an OR of the words
+ * 	the input data is ROW x COL x NB values, each pixel packed into BINARY_NB_WORD(NB) words
+ */
+template<int ROW, int COL, int NB, int POOL_ROW = 2, int POOL_COL = 2, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL>
+class MaxPooling2D_Binary
+{
+public:
+	MaxPooling2D_Binary()
+	{
+		assert(OUT_ROW > 0);
+		assert(OUT_COL > 0);
+#if DEBUG
+		cout<<"MaxPooling2D_Binary Layer......"<<endl;
+		cout<<"\tROW = " << ROW << endl;
+		cout<<"\tCOL = " << COL << endl;
+		cout<<"\tNB = " << NB << endl;
+		cout<<"\tPOOL_ROW = " << POOL_ROW << endl;
+		cout<<"\tPOOL_COL = " << POOL_COL << endl;
+		cout<<"\tOUT_ROW = " << OUT_ROW << endl;
+		cout<<"\tOUT_COL = " << OUT_COL << endl;
+#endif
+	}
+public:
+	TYPE_BWORD res[OUT_ROW][OUT_COL][BINARY_NB_WORD(NB)];
+
+public:
+	/*
+	 * @note: the input data is ROW x COL x BINARY_NB_WORD(NB) 3D array
+	 */
+	void feedforward(TYPE_BWORD data[ROW][COL][BINARY_NB_WORD(NB)])
+	{
+		for (int row = 0; row < OUT_ROW; row++)
+		{
+			for (int col = 0; col < OUT_COL; col++)
+			{
+#if POOLING2D_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+				for (int k = 0; k < BINARY_NB_WORD(NB); k++)
+				{
+					/* a value is +1 if any value in the local window is +1 */
+					TYPE_BWORD max = 0;
+					for (int i = 0; i < POOL_ROW; i++)
+					{
+						for (int j = 0; j < POOL_COL; j++)
+						{
+#if POOLING2D_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+							max |= data[row * POOL_ROW + i][col * POOL_COL + j][k];
+						}
+					}
+					res[row][col][k] = max;
+				}
+			}
+		}
+	}
+};
+
 /*
  * @note: the 2D average pooling layer, normally used after Convolution2D layer
  */
-template<int ROW, int COL, int NB, int POOL_ROW, int POOL_COL, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL>
+template<int ROW, int COL, int NB, int POOL_ROW, int POOL_COL, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL, typename DATA_T = TYPE_T, typename ACC_T = TYPE_T>
 class AveragePooling2D
 {
 public:
@@ -226,13 +342,14 @@ public:
 #endif
 	}
 public:
-	TYPE_T res[OUT_ROW][OUT_COL][NB];
+	DATA_T res[OUT_ROW][OUT_COL][NB];
 
 public:
 	/*
 	 * @note: the input data is ROW x COL x NB 3D array
 	 */
-	void feedforward(TYPE_T data[ROW][COL][NB])
+	template<typename IN_T>
+	void feedforward(IN_T data[ROW][COL][NB])
 	{
 		for( int row = 0; row < OUT_ROW; row++)
 		{
@@ -250,7 +367,7 @@ public:
 #pragma HLS pipeline
 #endif
 					/* calculate the mean value in the local window*/
-					TYPE_T sum = 0;
+					ACC_T sum = 0;
 					for( int i = 0; i < POOL_ROW; i++)
 					{
 						for( int j = 0; j < POOL_COL; j++)
@@ -258,10 +375,56 @@ public:
 #if POOLING2D_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-							sum += data[row*POOL_ROW + i][col*POOL_COL + j][k];
+							sum += (DATA_T)data[row*POOL_ROW + i][col*POOL_COL + j][k];
 						}
 					}
-					res[row][col][k] = sum/(POOL_ROW * POOL_COL);
+					res[row][col][k] = (DATA_T)(sum/(POOL_ROW * POOL_COL));
+				}
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, the ROW x COL x NB input is read once in order and
+	 * 	each pooled row is written after its last input row
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		/* the running sum of the current pooled row */
+		ACC_T	pool[OUT_COL][NB];
+
+		for( int row = 0; row < ROW; row++)
+		{
+			for( int col = 0; col < COL; col++)
+			{
+				for( int k = 0; k < NB; k++)
+				{
+#pragma HLS pipeline
+					DATA_T v = in.read();
+
+					/* the input out of the pooling windows is dropped */
+					if( row < OUT_ROW * POOL_ROW && col < OUT_COL * POOL_COL )
+					{
+						int p = col / POOL_COL;
+						if( row % POOL_ROW == 0 && col % POOL_COL == 0 )
+							pool[p][k] = v;
+						else
+							pool[p][k] += v;
+					}
+				}
+			}
+
+			/* write the pooled row */
+			if( row < OUT_ROW * POOL_ROW && row % POOL_ROW == POOL_ROW - 1 )
+			{
+				for( int col = 0; col < OUT_COL; col++)
+				{
+					for( int k = 0; k < NB; k++)
+					{
+#pragma HLS pipeline
+						out.write((DATA_T)(pool[col][k]/(POOL_ROW * POOL_COL)));
+					}
 				}
 			}
 		}
@@ -272,7 +435,7 @@ public:
 /*
  * @note: the 2D average pooling layer, normally used after Convolution2D layer
  */
-template<int ROW, int COL, int NB, int POOL_ROW, int POOL_COL, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL>
+template<int ROW, int COL, int NB, int POOL_ROW, int POOL_COL, int OUT_ROW = ROW/POOL_ROW, int OUT_COL = COL/POOL_COL, typename DATA_T = TYPE_T, typename ACC_T = TYPE_T>
 class AveragePooling2D_Stream
 {
 public:
@@ -290,18 +453,24 @@ public:
 #endif
 	}
 public:
-	TYPE_T res[OUT_ROW][OUT_COL][NB];
+	DATA_T res[OUT_ROW][OUT_COL][NB];
 
 public:
 	/*
 	 * @note: the input data is ROW x COL x NB 3D array
 	 */
-	void feedforward(volatile TYPE_T *data, volatile TYPE_T *res )
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data, volatile DATA_T *res )
 	{
 #if POOLING2D_OPT_MODE == OPT_BUFFER
 		/* define a 3D LineBuffer */
-		LineBuffer3D<POOL_ROW, COL, NB, POOL_ROW>								l_buffer;
-		WindowBuffer3D<POOL_ROW, POOL_COL, NB, COL, POOL_ROW, POOL_COL>			w_buffer;
+#if OPT_BUFFER_CIRCULAR
+		LineBuffer3D_Circular<POOL_ROW, COL, NB, POOL_ROW, DATA_T>						l_buffer;
+		WindowBuffer3D_Circular<POOL_ROW, POOL_COL, NB, COL, POOL_ROW, POOL_COL, DATA_T>	w_buffer;
+#else
+		LineBuffer3D<POOL_ROW, COL, NB, POOL_ROW, DATA_T>						l_buffer;
+		WindowBuffer3D<POOL_ROW, POOL_COL, NB, COL, POOL_ROW, POOL_COL, DATA_T>	w_buffer;
+#endif
 
 		/* fill the line buffer and window buffer */
 		l_buffer.fill( data );
@@ -309,7 +478,7 @@ public:
 
 #elif POOLING2D_OPT_MODE == OPT_MEM
 		/* define a local BRAM to store part of the data */
-		Reshape_Stream_3D<POOL_ROW, COL, NB>	stream;
+		Reshape_Stream_3D<POOL_ROW, COL, NB, ORDER_X, DATA_T>	stream;
 
 #endif
 
@@ -354,7 +523,7 @@ public:
 #pragma HLS pipeline
 #endif
 					/* calculate the mean value in the local window*/
-					TYPE_T sum = 0;
+					ACC_T sum = 0;
 					for( int i = 0; i < POOL_ROW; i++)
 					{
 						for( int j = 0; j < POOL_COL; j++)
@@ -364,17 +533,17 @@ public:
 #endif
 
 #if POOLING2D_OPT_MODE == OPT_BUFFER
-							TYPE_T v = w_buffer.getval(i, j, k);
+							DATA_T v = w_buffer.getval(i, j, k);
 #elif POOLING2D_OPT_MODE == OPT_MEM
-							TYPE_T v = stream.res[i][col * POOL_COL + j][k];
+							DATA_T v = stream.res[i][col * POOL_COL + j][k];
 #else
-							TYPE_T v = data[(row * POOL_ROW + i) * COL * NB + (col * POOL_COL + j) * NB + k];
+							DATA_T v = (IN_T)data[(row * POOL_ROW + i) * COL * NB + (col * POOL_COL + j) * NB + k];
 #endif
 							sum += v;
 
 						}
 					}
-					res[row * OUT_COL * NB + col * NB + k] = sum/(POOL_ROW * POOL_COL);
+					res[row * OUT_COL * NB + col * NB + k] = (DATA_T)(sum/(POOL_ROW * POOL_COL));
 				}
 			}
 		}
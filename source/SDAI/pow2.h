@@ -0,0 +1,157 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __POW2_H__
+#define __POW2_H__
+#include <math.h>
+#include <assert.h>
+#include "configure.h"
+#include "activation.h"
+
+#if DEBUG
+#include <iostream>
+using namespace std;
+#endif
+
+namespace SDAI
+{
+/*
+ * @note: the power of two weight, a weight is the sum of NB_TERM terms +-2^e with e in [POW2_EXP_MIN, POW2_EXP_MAX],
+ * 	so the product of a data and a weight is NB_TERM shifts and additions instead of a multiplier
+ * 	a term is kept in a TYPE_POW2 as the code sign * (e - POW2_EXP_MIN + 1), the code 0 is a zero term
+ * 	the layers take the float weight arrays of top.h, so Convolution2D_Pow2 and Dense_Pow2 replace Convolution2D and Dense
+ * 	in Neural(), example/hls/testbench/pow2_lenet_tb.cpp checks the accuracy of LeNet_v2 against result.txt for each NB_TERM
+ */
+#define POW2_EXP_MIN		-16
+#define POW2_EXP_MAX		7
+
+/*
+ * @note: x * 2^e, the float types only change the exponent, the fixed point types are shifted
+ * 	and the bits shifted out are lost as in the shift of ap_fixed
+ */
+inline float pow2_shift(float x, int e)
+{
+#pragma HLS INLINE
+	return ldexpf(x, e);
+}
+
+inline double pow2_shift(double x, int e)
+{
+#pragma HLS INLINE
+	return ldexp(x, e);
+}
+
+template<int W, int I, ap_q_mode Q, ap_o_mode O>
+inline ap_fixed<W, I, Q, O> pow2_shift(ap_fixed<W, I, Q, O> x, int e)
+{
+#pragma HLS INLINE
+	return e >= 0 ? (ap_fixed<W, I, Q, O>)(x << e) : (ap_fixed<W, I, Q, O>)(x >> -e);
+}
+
+template<int W, int I, ap_q_mode Q, ap_o_mode O>
+inline Fixed<W, I, Q, O> pow2_shift(Fixed<W, I, Q, O> x, int e)
+{
+	Fixed<W, I, Q, O> r;
+	long long v = e >= 0 ? (long long)x.V * (1LL << e) : (long long)x.V >> -e;
+	r.V = fixed_overflow<W, AP_WRAP>(v);
+	return r;
+}
+
+/*
+ * @note: the real value of a term
+ */
+inline double pow2_value(TYPE_POW2 code)
+{
+	if( code == 0 )
+		return 0;
+	double v = ldexp(1.0, ABS(code) - 1 + POW2_EXP_MIN);
+	return code > 0 ? v : -v;
+}
+
+/*
+ * @note: the nearest term of w
+ */
+inline TYPE_POW2 pow2_encode(double w)
+{
+	double a = ABS(w);
+	if( a < ldexp(0.75, POW2_EXP_MIN) )
+		return 0;
+
+	/* 2^e <= a < 2^(e+1), the midpoint is 1.5 * 2^e */
+	int e;
+	frexp(a, &e);
+	e -= 1;
+	if( a >= ldexp(1.5, e) )
+		e++;
+	if( e < POW2_EXP_MIN )
+		e = POW2_EXP_MIN;
+	if( e > POW2_EXP_MAX )
+		e = POW2_EXP_MAX;
+	int code = e - POW2_EXP_MIN + 1;
+	return (TYPE_POW2)(w > 0 ? code : -code);
+}
+
+/*
+ * @note: convert N float weights to NB_TERM terms each, the next term is the nearest term of what is left
+ */
+template<int NB_TERM>
+void pow2_convert(const TYPE_T *WEIGHT, int N, TYPE_POW2 *weight)
+{
+	for( int i = 0; i < N; i++)
+	{
+		double left = WEIGHT[i];
+		for( int s = 0; s < NB_TERM; s++)
+		{
+			weight[i * NB_TERM + s] = pow2_encode(left);
+			left -= pow2_value(weight[i * NB_TERM + s]);
+		}
+	}
+}
+
+/*
+ * @note: the error of the NB_TERM power of two weights against N float weights, it is used on the host to choose NB_TERM
+ */
+template<int NB_TERM>
+void pow2_error(const TYPE_T *WEIGHT, int N, float &max_err, float &mean_err)
+{
+	max_err = 0;
+	mean_err = 0;
+	for( int i = 0; i < N; i++)
+	{
+		TYPE_POW2 t[NB_TERM];
+		pow2_convert<NB_TERM>(&WEIGHT[i], 1, t);
+		double v = 0;
+		for( int s = 0; s < NB_TERM; s++)
+			v += pow2_value(t[s]);
+		float err = ABS(v - (double)WEIGHT[i]);
+		if( err > max_err )
+			max_err = err;
+		mean_err += err;
+	}
+	mean_err /= N;
+#if DEBUG
+	cout<<"Power of two weight......"<<endl;
+	cout<<"	NB_TERM = " << NB_TERM << endl;
+	cout<<"	max error = " << max_err << ", mean error = " << mean_err << endl;
+#endif
+}
+
+/*
+ * @note: t += x * w for a term w of a weight, x is shifted in the type of the sum
+ */
+template<typename ACC_T, typename DATA_T>
+inline void pow2_mac(ACC_T &t, DATA_T x, TYPE_POW2 code)
+{
+#pragma HLS INLINE
+	if( code == 0 )
+		return;
+	ACC_T v = pow2_shift((ACC_T)x, ABS(code) - 1 + POW2_EXP_MIN);
+	if( code > 0 )
+		t += v;
+	else
+		t -= v;
+}
+
+}
+
+#endif
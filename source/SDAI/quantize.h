@@ -0,0 +1,156 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __QUANTIZE_H__
+#define __QUANTIZE_H__
+#include <math.h>
+#include <assert.h>
+#include "configure.h"
+#include "activation.h"
+
+namespace SDAI
+{
+/*
+ * @note: the int8 quantization, a real value x is kept as q = round(x / scale) saturated to [-QUANTIZE_INT8_MAX, QUANTIZE_INT8_MAX],
+ * 	the zero point is always 0, so a product of two int8 values is a plain integer product
+ * 	the scale of the data is max|x| / QUANTIZE_INT8_MAX over the validation samples, e.g. from the range recorded by calibration()
+ */
+#define QUANTIZE_INT8_MAX		127
+
+/*
+ * @note: the multiplier of the requantization is a Q31 integer in [2^30, 2^31)
+ */
+#define QUANTIZE_MULT_BITS		31
+
+/*
+ * @note: quantize a real value to int8
+ */
+inline TYPE_INT8 quantize_int8(float x, float scale)
+{
+#pragma HLS INLINE
+	float q = x / scale;
+	if( q >= QUANTIZE_INT8_MAX )
+		return QUANTIZE_INT8_MAX;
+	if( q <= -QUANTIZE_INT8_MAX )
+		return -QUANTIZE_INT8_MAX;
+	return (TYPE_INT8)(q >= 0 ? (int)(q + 0.5f) : -(int)(0.5f - q));
+}
+
+/*
+ * @note: the real value of an int8
+ */
+inline float dequantize_int8(TYPE_INT8 q, float scale)
+{
+#pragma HLS INLINE
+	return q * scale;
+}
+
+/*
+ * @note: quantize a whole array, it converts the float input of the first int8 layer
+ */
+template<int N, typename T>
+void quantize_array(const T x[N], float scale, TYPE_INT8 q[N])
+{
+	for( int i = 0; i < N; i++)
+	{
+#pragma HLS pipeline
+		q[i] = quantize_int8(x[i], scale);
+	}
+}
+
+/*
+ * @note: dequantize a whole array, it converts the output of the last int8 layer
+ */
+template<int N, typename T>
+void dequantize_array(const TYPE_INT8 q[N], float scale, T x[N])
+{
+	for( int i = 0; i < N; i++)
+	{
+#pragma HLS pipeline
+		x[i] = dequantize_int8(q[i], scale);
+	}
+}
+
+/*
+ * @note: split the real multiplier M > 0 into M = mult * 2^-shift, mult is a Q31 integer in [2^30, 2^31),
+ * 	a multiplier too small for a 62 bit shift gives mult = 0
+ */
+inline void quantize_multiplier(double M, TYPE_INT32 &mult, int &shift)
+{
+	int e;
+	double f = frexp(M, &e);
+	long long m = (long long)floor(f * (1LL << QUANTIZE_MULT_BITS) + 0.5);
+	if( m == (1LL << QUANTIZE_MULT_BITS) )
+	{
+		m /= 2;
+		e++;
+	}
+	shift = QUANTIZE_MULT_BITS - e;
+	assert(shift > 0);
+	if( M <= 0 || shift > 62 )
+	{
+		m = 0;
+		shift = 1;
+	}
+	mult = (TYPE_INT32)m;
+}
+
+/*
+ * @note: requantize an int32 sum to int8, round(acc * mult * 2^-shift) saturated to int8,
+ * 	RELU only clips the lower bound at 0 since the zero point is 0
+ */
+template<ACTIVATION AC_FN>
+inline TYPE_INT8 requantize(TYPE_INT32 acc, TYPE_INT32 mult, int shift)
+{
+#pragma HLS INLINE
+	long long p = (long long)acc * mult;
+	p = (p + (1LL << (shift - 1))) >> shift;
+	const int lo = AC_FN == RELU ? 0 : -QUANTIZE_INT8_MAX;
+	if( p < lo )
+		return lo;
+	if( p > QUANTIZE_INT8_MAX )
+		return QUANTIZE_INT8_MAX;
+	return (TYPE_INT8)p;
+}
+
+/*
+ * @note: quantize the NB_IN x NB_OUT row major float weight with a scale per output channel (per column),
+ * 	the scale of the column j is max|WEIGHT[., j]| / QUANTIZE_INT8_MAX
+ * 	the bias is kept in int32 with the scale IN_SCALE * scale[j] of the sum of products,
+ * 	and mult[j], shift[j] requantize the sum to the output scale OUT_SCALE
+ */
+template<int NB_IN, int NB_OUT>
+void quantize_weight_int8(const TYPE_T *WEIGHT, const TYPE_T *BIAS, float IN_SCALE, float OUT_SCALE,
+		TYPE_INT8 *weight, TYPE_INT32 *bias, TYPE_INT32 *mult, int *shift)
+{
+	assert(IN_SCALE > 0);
+	assert(OUT_SCALE > 0);
+	for( int j = 0; j < NB_OUT; j++)
+	{
+		float max = 0;
+		for( int i = 0; i < NB_IN; i++)
+		{
+			float w = WEIGHT[i * NB_OUT + j];
+			if( ABS(w) > max )
+				max = ABS(w);
+		}
+		float scale = max > 0 ? max / QUANTIZE_INT8_MAX : 1.0f;
+
+		for( int i = 0; i < NB_IN; i++)
+			weight[i * NB_OUT + j] = quantize_int8(WEIGHT[i * NB_OUT + j], scale);
+
+		/* the bias is saturated to int32 */
+		double b = floor((double)BIAS[j] / ((double)IN_SCALE * scale) + 0.5);
+		if( b > 2147483647.0 )
+			b = 2147483647.0;
+		if( b < -2147483647.0 )
+			b = -2147483647.0;
+		bias[j] = (TYPE_INT32)b;
+
+		quantize_multiplier((double)IN_SCALE * scale / OUT_SCALE, mult[j], shift[j]);
+	}
+}
+
+}
+
+#endif
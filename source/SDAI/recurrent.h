@@ -6,6 +6,10 @@
 #define __RECURRENT_H__
 #include "activation.h"
 #include "configure.h"
+#include "stream.h"
+#include "host.h"
+#include "calibration.h"
+#include "mem.h"
 #include <assert.h>
 
 
@@ -16,10 +20,22 @@ using namespace std;
 
 namespace SDAI
 {
+
+/*
+ * @note: the gate order in the packed weight of LSTM and GRU, the gates of one unit are stored next to each other
+ */
+typedef enum{GATE_I, GATE_C, GATE_F, GATE_O, NB_LSTM_GATE}LSTM_GATE;
+typedef enum{GATE_Z, GATE_R, GATE_H, NB_GRU_GATE}GRU_GATE;
+
+/*
+ * @note: how the two directions of Bidirectional are merged
+ */
+typedef enum{MERGE_CONCAT, MERGE_SUM}MERGE_MODE;
+
 /*
  * @note: define the Simple RNN based on Elman Neural Network, http://outlace.com/Simple-Recurrent-Neural-Network/
  */
-template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN >
+template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN, typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
 class SimpleRNN
 {
 public:
@@ -39,322 +55,1328 @@ public:
 				weight[i][j] = WEIGHT[i * OUTPUT_DIM + j];
 			}
 		}
+#if CALIBRATION_HOST
+		calib = calibration().find("SimpleRNN", WEIGHT);
+		calibration().weight(calib, &weight[0][0], (OUTPUT_DIM + INPUT_DIM + 1) * OUTPUT_DIM);
+#endif
 	}
 
 public:
-	TYPE_T	weight[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T	res[OUTPUT_DIM];
+	WEIGHT_T	weight[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
+	DATA_T		res[OUTPUT_DIM];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 	/*
 	 *@note: the feedforward function
 	 */
-	void feedforward(TYPE_T data[INPUT_LENGTH][INPUT_DIM])
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM])
 	{
-		/* initialize the context */
-		for( int i = 0; i < OUTPUT_DIM; i++)
+		feedforward(data, INPUT_LENGTH);
+	}
+
+	/*
+	 * @note: the feedforward function of a padded sequence, only the first length timesteps are calculated
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM], int length)
+	{
+#if RECURRENT_INPUT_PRECOMPUTE
+		/* calculate the input weight and bias of all the timesteps before the recurrence */
+		ACC_T	wx[INPUT_LENGTH][OUTPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
 		{
-#pragma HLS pipeline
-			res[i] = 0;
+			if( i == length )
+				break;
+			input_projection(data[i], wx[i]);
 		}
+#endif
+
+		/* initialize the context */
+		reset_state();
 
 		for(int i = 0; i < INPUT_LENGTH; i++)
 		{
 #if RECURRENT_PERF_MODE == PERF_HIGH
 #pragma HLS pipeline
 #endif
-			for( int j = 0; j <OUTPUT_DIM; j++)
-			{
-#if RECURRENT_PERF_MODE == PERF_MEDIAN
-#pragma HLS pipeline
+			if( i == length )
+				break;
+#if RECURRENT_INPUT_PRECOMPUTE
+			recurrence(wx[i]);
+#else
+			step(data[i]);
 #endif
-				/* add the bias */
-				TYPE_T tmp = weight[OUTPUT_DIM + INPUT_DIM][j];
+		}
+	}
 
-				/* add the input weight */
-				for( int k = 0; k < INPUT_DIM; k++)
-				{
-#if RECURRENT_PERF_MODE == PERF_LOW
+	/*
+	 * @note: advance the context by one timestep, h(t) is left in res
+	 */
+	template<typename IN_T>
+	void step(const IN_T x[INPUT_DIM])
+	{
+		ACC_T	wx[OUTPUT_DIM];
+		input_projection(x, wx);
+		recurrence(wx);
+	}
+
+	/*
+	 * @note: clear the context before a new sequence is fed with step()
+	 */
+	void reset_state()
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
 #pragma HLS pipeline
-#endif
-					tmp += data[i][k] * weight[k][j];
-				}
+			res[i] = 0;
+		}
+	}
 
-				/* add the memory cell weight */
-				for( int k = 0; k < OUTPUT_DIM; k++)
-				{
-#if RECURRENT_PERF_MODE == PERF_LOW
+	/*
+	 * @note: save and restore the context, one layer can serve several independent sequences in turn
+	 */
+	void save_state(DATA_T h[OUTPUT_DIM])
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
 #pragma HLS pipeline
-#endif
-					tmp += res[k] * weight[k + INPUT_DIM][j];
-				}
+			h[i] = res[i];
+		}
+	}
 
-				/* calculate the activation function */
-				res[j] = activation_fn<AC_FN>(tmp);
-			}
+	void restore_state(const DATA_T h[OUTPUT_DIM])
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			res[i] = h[i];
+		}
+	}
 
-			/* for the activation of softmax */
-			if( AC_FN == SOFTMAX )
+	/*
+	 * @note: the feedforward function with FIFO channels, one sequence of INPUT_LENGTH x INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_LENGTH][INPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			for( int j = 0; j < INPUT_DIM; j++)
 			{
-				activation_softmax<OUTPUT_DIM>(res);
+#pragma HLS pipeline
+				data[i][j] = in.read();
 			}
 		}
-	}
-};
 
+		feedforward(data);
 
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
 
-/*
- * @note: define the Gated Recurrent Neural Network, https://arxiv.org/pdf/1412.3555v1.pdf
- */
-template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN = TANH, ACTIVATION INNER_AC_FN = SIGMOID>
-class GRU
-{
-public:
-	GRU(const TYPE_T *WEIGHT_Z, const TYPE_T *WEIGHT_R, const TYPE_T *WEIGHT_H)
+	/*
+	 * @note: the feedforward function returning the sequence, h(t) of every timestep is written to seq
+	 */
+	template<typename IN_T>
+	void feedforward_sequences(IN_T data[INPUT_LENGTH][INPUT_DIM], DATA_T seq[INPUT_LENGTH][OUTPUT_DIM])
 	{
-#if DEBUG
-		cout<<"GRU Layer......"<<endl;
-		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
-		cout<<"\tINPUT_LENGTH = " << INPUT_LENGTH << endl;
-#endif
+		reset_state();
 
-		/* initialize the weights */
-		for( int i = 0; i < OUTPUT_DIM + INPUT_DIM + 1; i++)
+		for( int i = 0; i < INPUT_LENGTH; i++)
 		{
+			step(data[i]);
 			for( int j = 0; j < OUTPUT_DIM; j++)
 			{
-				weight_z[i][j] = WEIGHT_Z[i*OUTPUT_DIM + j];
-				weight_r[i][j] = WEIGHT_R[i*OUTPUT_DIM + j];
-				weight_h[i][j] = WEIGHT_H[i*OUTPUT_DIM + j];
+#pragma HLS pipeline
+				seq[i][j] = res[j];
 			}
 		}
 	}
-public:
-	TYPE_T	weight_z[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T	weight_r[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T	weight_h[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T	res[OUTPUT_DIM];
-	TYPE_T	rr[OUTPUT_DIM];
-	TYPE_T	zz[OUTPUT_DIM];
-	TYPE_T	rh[OUTPUT_DIM];
 
-public:
 	/*
-	 * @note: the feedforward function
+	 * @note: the feedforward function returning the sequence with FIFO channels, INPUT_DIM is read and OUTPUT_DIM is written per timestep
+	 * 	so a following recurrent layer can start on h(t) while this layer works on x(t+1)
 	 */
-	void feedforward(TYPE_T data[INPUT_LENGTH][INPUT_DIM])
+	template<typename IN_T>
+	void feedforward_sequences(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
 	{
-		/* initialize the context */
-		for( int i = 0; i < OUTPUT_DIM; i++)
+		reset_state();
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
 		{
+			DATA_T x[INPUT_DIM];
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
 #pragma HLS pipeline
-			res[i] = 0;
-			rr[i] = 0;
-			zz[i] = 0;
-			rh[i] = 0;
+				x[j] = in.read();
+			}
+
+			step(x);
+
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				out.write(res[j]);
+			}
 		}
+	}
 
-		for(int i = 0; i < INPUT_LENGTH; i++)
+private:
+	/*
+	 * @note: calculate the input weight and bias of one timestep
+	 */
+	template<typename IN_T>
+	void input_projection(const IN_T x[INPUT_DIM], ACC_T wx[OUTPUT_DIM])
+	{
+#pragma HLS inline
+#if HOST_NATIVE
+		host_gemv<DATA_T, ACC_T, OUTPUT_DIM, INPUT_DIM>(x, &weight[0][0], weight[OUTPUT_DIM + INPUT_DIM], wx);
+		return;
+#endif
+		for( int j = 0; j < OUTPUT_DIM; j++)
 		{
-#if RECURRENT_PERF_MODE == PERF_HIGH
+#if RECURRENT_PERF_MODE == PERF_HIGH || RECURRENT_PERF_MODE == PERF_MEDIAN
 #pragma HLS pipeline
 #endif
-			for( int j = 0; j <OUTPUT_DIM; j++)
+			ACC_T tmp = weight[OUTPUT_DIM + INPUT_DIM][j];
+			for( int k = 0; k < INPUT_DIM; k++)
 			{
-#if RECURRENT_PERF_MODE == PERF_MEDIAN
-#pragma HLS pipeline
-#endif
-				/* add the bias */
-				TYPE_T r = weight_r[OUTPUT_DIM + INPUT_DIM][j];
-				TYPE_T z = weight_z[OUTPUT_DIM + INPUT_DIM][j];
-
-				/* add the input data weight */
-				for( int k = 0; k < INPUT_DIM; k++)
-				{
 #if RECURRENT_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-					TYPE_T xk = data[i][k];
-					r += weight_r[k][j] * xk;
-					z += weight_z[k][j] * xk;
-				}
+				tmp += (DATA_T)x[k] * weight[k][j];
+			}
+			wx[j] = tmp;
+		}
+	}
 
-				for( int k = 0; k < OUTPUT_DIM; k++)
-				{
-#if RECURRENT_PERF_MODE == PERF_LOW
-#pragma HLS pipeline
+	/*
+	 * @note: add the memory cell weight to the input projection and update the context
+	 */
+	void recurrence(const ACC_T wx[OUTPUT_DIM])
+	{
+#pragma HLS inline
+#if HOST_NATIVE
+		/* h(t - 1) times the row major recurrent weight */
+		ACC_T	pre[OUTPUT_DIM];
+		host_gemv<DATA_T, ACC_T, OUTPUT_DIM, OUTPUT_DIM>(res, &weight[INPUT_DIM][0], wx, pre);
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+			res[j] = (DATA_T)pre[j];
+		}
+		activation_apply<AC_FN, OUTPUT_DIM>(res);
+		if( AC_FN == SOFTMAX )
+		{
+			activation_softmax<OUTPUT_DIM>(res);
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, res, OUTPUT_DIM);
 #endif
-					TYPE_T prev_h = res[k];
-					r += prev_h * weight_r[k + INPUT_DIM][j];
-					z += prev_h * weight_z[k + INPUT_DIM][j];
-				}
-
-				/* calculate the inner activation function */
-				rr[j] = activation_fn<INNER_AC_FN>(r);
-				zz[j] = activation_fn<INNER_AC_FN>(z);
-
-				/* calculate the r * h */
-				rh[j] = rr[j] * res[j];
-			}
+		return;
+#endif
+		/* keep h(t-1) while h(t) is calculated */
+		DATA_T	prev_h[OUTPUT_DIM];
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+			prev_h[j] = res[j];
+		}
 
-			/* calculate the new h*/
-			for( int j = 0; j < OUTPUT_DIM; j++)
-			{
+		for( int j = 0; j <OUTPUT_DIM; j++)
+		{
 #if RECURRENT_PERF_MODE == PERF_MEDIAN
 #pragma HLS pipeline
 #endif
-				/* add the W and bias*/
-				TYPE_T h_new = weight_h[OUTPUT_DIM + INPUT_DIM][j];
-				for(int k = 0; k < INPUT_DIM; k++)
-				{
-#if RECURRENT_PERF_MODE == PERF_LOW
-#pragma HLS pipeline
-#endif
-					h_new += weight_h[k][j] * data[i][k];
-				}
+			/* the input weight and bias */
+			ACC_T tmp = wx[j];
 
-				for( int k = 0; k < OUTPUT_DIM; k++)
-				{
+			/* add the memory cell weight */
+			for( int k = 0; k < OUTPUT_DIM; k++)
+			{
 #if RECURRENT_PERF_MODE == PERF_LOW
 #pragma HLS pipeline
 #endif
-					h_new += rh[j] * weight_h[k + INPUT_DIM][j];
-				}
-
-
-				TYPE_T hh_new;
-				hh_new = activation_fn<AC_FN>(h_new);
-
-				/* calculate and update the final result */
-				res[j] = (1 - zz[j]) * res[j] + zz[j] * hh_new;
+				tmp += prev_h[k] * weight[k + INPUT_DIM][j];
 			}
 
-			/* for the activation of softmax */
-			if( AC_FN == SOFTMAX )
-			{
-				activation_softmax<OUTPUT_DIM>(res);
-			}
+			/* calculate the activation function */
+			res[j] = activation_fn<AC_FN, DATA_T>((DATA_T)tmp);
 		}
-	}
 
+		/* for the activation of softmax */
+		if( AC_FN == SOFTMAX )
+		{
+			activation_softmax<OUTPUT_DIM>(res);
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, res, OUTPUT_DIM);
+#endif
+	}
 };
 
+
+
 /*
- * @note: define the Long Short Term Memory(LSTM) Neural Network, http://deeplearning.net/tutorial/lstm.html
+ * @note: define the Gated Recurrent Neural Network, https://arxiv.org/pdf/1412.3555v1.pdf
  */
-template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN = TANH, ACTIVATION INNER_AC_FN = SIGMOID>
-class LSTM
+template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN = TANH, ACTIVATION INNER_AC_FN = SIGMOID,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class GRU
 {
 public:
-	LSTM(const TYPE_T *WEIGHT_I, const TYPE_T *WEIGHT_C, const TYPE_T *WEIGHT_F, const TYPE_T *WEIGHT_O)
+	GRU(const TYPE_T *WEIGHT_Z, const TYPE_T *WEIGHT_R, const TYPE_T *WEIGHT_H)
 	{
-#pragma HLS ARRAY_PARTITION variable=weight_o block factor=4 dim=1
-
-
+#pragma HLS ARRAY_RESHAPE variable=weight cyclic factor=3 dim=2
 #if DEBUG
-		cout<<"LSTM Layer......"<<endl;
+		cout<<"GRU Layer......"<<endl;
 		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
 		cout<<"\tINPUT_LENGTH = " << INPUT_LENGTH << endl;
 #endif
 
-		/* initialize the weights */
+		/* initialize the weights, the gates of one unit are interleaved */
 		for( int i = 0; i < OUTPUT_DIM + INPUT_DIM + 1; i++)
 		{
-			for(int j = 0; j < OUTPUT_DIM; j++)
+			for( int j = 0; j < OUTPUT_DIM; j++)
 			{
-				weight_i[i][j] = WEIGHT_I[i*OUTPUT_DIM + j];
-				weight_c[i][j] = WEIGHT_C[i*OUTPUT_DIM + j];
-				weight_f[i][j] = WEIGHT_F[i*OUTPUT_DIM + j];
-				weight_o[i][j] = WEIGHT_O[i*OUTPUT_DIM + j];
+				weight[i][j * NB_GRU_GATE + GATE_Z] = WEIGHT_Z[i*OUTPUT_DIM + j];
+				weight[i][j * NB_GRU_GATE + GATE_R] = WEIGHT_R[i*OUTPUT_DIM + j];
+				weight[i][j * NB_GRU_GATE + GATE_H] = WEIGHT_H[i*OUTPUT_DIM + j];
 			}
 		}
+#if CALIBRATION_HOST
+		calib = calibration().find("GRU", WEIGHT_Z);
+		calibration().weight(calib, &weight[0][0], (OUTPUT_DIM + INPUT_DIM + 1) * NB_GRU_GATE * OUTPUT_DIM);
+#endif
 	}
-
 public:
-	TYPE_T weight_i[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T weight_c[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T weight_f[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T weight_o[OUTPUT_DIM + INPUT_DIM + 1][OUTPUT_DIM];
-	TYPE_T	res[OUTPUT_DIM];
-	TYPE_T	ct[OUTPUT_DIM];
+	/* the packed weight, weight[k][j * NB_GRU_GATE + GATE_Z/GATE_R/GATE_H] */
+	WEIGHT_T	weight[OUTPUT_DIM + INPUT_DIM + 1][NB_GRU_GATE * OUTPUT_DIM];
+	DATA_T		res[OUTPUT_DIM];
+	DATA_T		rr[OUTPUT_DIM];
+	DATA_T		zz[OUTPUT_DIM];
+	DATA_T		rh[OUTPUT_DIM];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
 
 public:
 	/*
-	 * @note: the feed forward function
+	 * @note: the feedforward function
 	 */
-	void feedforward(TYPE_T data[INPUT_LENGTH][INPUT_DIM])
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM])
 	{
-		/* initialize the context */
-		for( int i = 0; i < OUTPUT_DIM; i++)
+		feedforward(data, INPUT_LENGTH);
+	}
+
+	/*
+	 * @note: the feedforward function of a padded sequence, only the first length timesteps are calculated
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM], int length)
+	{
+#if RECURRENT_INPUT_PRECOMPUTE
+		/* calculate the input weight and bias of all the timesteps before the recurrence */
+		ACC_T	wx[INPUT_LENGTH][NB_GRU_GATE * OUTPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
 		{
-			res[i] = 0;
-			ct[i] = 0;
+			if( i == length )
+				break;
+			input_projection(data[i], wx[i]);
 		}
+#endif
 
-		for( int i = 0; i < INPUT_LENGTH; i++)
+		/* initialize the context */
+		reset_state();
+
+		for(int i = 0; i < INPUT_LENGTH; i++)
 		{
 #if RECURRENT_PERF_MODE == PERF_HIGH
 #pragma HLS pipeline
 #endif
-			for( int j = 0; j < OUTPUT_DIM; j++)
-			{
-#if RECURRENT_PERF_MODE == PERF_MEDIAN
-#pragma HLS pipeline
-#endif
-				/* calculate the W and b*/
-				TYPE_T	it =  weight_i[ OUTPUT_DIM + INPUT_DIM][j];
-				TYPE_T	cc =  weight_c[ OUTPUT_DIM + INPUT_DIM][j];
-				TYPE_T 	ft =  weight_f[ OUTPUT_DIM + INPUT_DIM][j];
-				TYPE_T  ot =  weight_o[ OUTPUT_DIM + INPUT_DIM][j];
-				for( int k = 0; k < INPUT_DIM; k++)
-				{
-#if RECURRENT_PERF_MODE == PERF_LOW
-#pragma HLS pipeline
+			if( i == length )
+				break;
+#if RECURRENT_INPUT_PRECOMPUTE
+			recurrence(wx[i]);
+#else
+			step(data[i]);
 #endif
-					TYPE_T xk = data[i][k];
-					it += (weight_i[k][j] * xk);
-					cc += (weight_c[k][j] * xk);
-					ft += (weight_f[k][j] * xk);
-					ot += (weight_o[k][j] * xk);
-				}
+		}
+	}
 
+	/*
+	 * @note: advance the context by one timestep, h(t) is left in res
+	 */
+	template<typename IN_T>
+	void step(const IN_T x[INPUT_DIM])
+	{
+		ACC_T	wx[NB_GRU_GATE * OUTPUT_DIM];
+		input_projection(x, wx);
+		recurrence(wx);
+	}
 
-				/* calculate the U */
-				for(int k = 0; k < OUTPUT_DIM; k++)
-				{
-#if RECURRENT_PERF_MODE == PERF_LOW
+	/*
+	 * @note: clear the context before a new sequence is fed with step()
+	 */
+	void reset_state()
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
 #pragma HLS pipeline
-#endif
-					TYPE_T	pre_h = res[k];
-					it += pre_h * weight_i[k + INPUT_DIM][j];
-					cc += pre_h * weight_c[k + INPUT_DIM][j];
-					ft += pre_h * weight_f[k + INPUT_DIM][j];
-					ot += pre_h * weight_o[k + INPUT_DIM][j];
-				}
-
-
-				/* the inner activation function */
-				TYPE_T it_o, ft_o, ot_o;
-				it_o = activation_fn<INNER_AC_FN>(it);
-				ft_o = activation_fn<INNER_AC_FN>(ft);
-				ot_o = activation_fn<INNER_AC_FN>(ot);
-
-				/* the activation function */
-				TYPE_T cc_o;
-				cc_o = activation_fn<AC_FN>(cc);
+			res[i] = 0;
+			rr[i] = 0;
+			zz[i] = 0;
+			rh[i] = 0;
+		}
+	}
 
-				/* calculate the memory cell output */
-				TYPE_T	ct_new = it_o * cc_o + ft_o * ct[j];
+	/*
+	 * @note: save and restore the context, one layer can serve several independent sequences in turn
+	 */
+	void save_state(DATA_T h[OUTPUT_DIM])
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			h[i] = res[i];
+		}
+	}
 
-				/* the activation function */
-				TYPE_T ct_o;
-				ct_o = activation_fn<AC_FN>(ct_new);
+	void restore_state(const DATA_T h[OUTPUT_DIM])
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			res[i] = h[i];
+		}
+	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, one sequence of INPUT_LENGTH x INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_LENGTH][INPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				data[i][j] = in.read();
+			}
+		}
+
+		feedforward(data);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
+
+	/*
+	 * @note: the feedforward function returning the sequence, h(t) of every timestep is written to seq
+	 */
+	template<typename IN_T>
+	void feedforward_sequences(IN_T data[INPUT_LENGTH][INPUT_DIM], DATA_T seq[INPUT_LENGTH][OUTPUT_DIM])
+	{
+		reset_state();
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			step(data[i]);
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				seq[i][j] = res[j];
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedforward function returning the sequence with FIFO channels, INPUT_DIM is read and OUTPUT_DIM is written per timestep
+	 * 	so a following recurrent layer can start on h(t) while this layer works on x(t+1)
+	 */
+	template<typename IN_T>
+	void feedforward_sequences(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		reset_state();
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			DATA_T x[INPUT_DIM];
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				x[j] = in.read();
+			}
+
+			step(x);
+
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				out.write(res[j]);
+			}
+		}
+	}
+
+private:
+	/*
+	 * @note: calculate the input weight and bias of one timestep, packed in the same gate order as weight
+	 */
+	template<typename IN_T>
+	void input_projection(const IN_T x[INPUT_DIM], ACC_T wx[NB_GRU_GATE * OUTPUT_DIM])
+	{
+#pragma HLS inline
+#if HOST_NATIVE
+		host_gemv<DATA_T, ACC_T, NB_GRU_GATE * OUTPUT_DIM, INPUT_DIM>(x, &weight[0][0], weight[OUTPUT_DIM + INPUT_DIM], wx);
+		return;
+#endif
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+#if RECURRENT_PERF_MODE == PERF_HIGH || RECURRENT_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+			ACC_T r = weight[OUTPUT_DIM + INPUT_DIM][j * NB_GRU_GATE + GATE_R];
+			ACC_T z = weight[OUTPUT_DIM + INPUT_DIM][j * NB_GRU_GATE + GATE_Z];
+			ACC_T h = weight[OUTPUT_DIM + INPUT_DIM][j * NB_GRU_GATE + GATE_H];
+			for( int k = 0; k < INPUT_DIM; k++)
+			{
+#if RECURRENT_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+				DATA_T xk = x[k];
+				r += weight[k][j * NB_GRU_GATE + GATE_R] * xk;
+				z += weight[k][j * NB_GRU_GATE + GATE_Z] * xk;
+				h += weight[k][j * NB_GRU_GATE + GATE_H] * xk;
+			}
+			wx[j * NB_GRU_GATE + GATE_R] = r;
+			wx[j * NB_GRU_GATE + GATE_Z] = z;
+			wx[j * NB_GRU_GATE + GATE_H] = h;
+		}
+	}
+
+	/*
+	 * @note: add the memory cell weight to the input projection and update the context
+	 */
+	void recurrence(const ACC_T wx[NB_GRU_GATE * OUTPUT_DIM])
+	{
+#pragma HLS inline
+#if HOST_NATIVE
+		{
+			/* the r and z gates, h(t - 1) times the row major recurrent weight, the h gate is calculated below with r * h */
+			ACC_T	pre[NB_GRU_GATE * OUTPUT_DIM];
+			ACC_T	h_new[OUTPUT_DIM];
+			DATA_T	hh[OUTPUT_DIM];
+			host_gemv<DATA_T, ACC_T, NB_GRU_GATE * OUTPUT_DIM, OUTPUT_DIM>(res, &weight[INPUT_DIM][0], wx, pre);
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				rr[j] = (DATA_T)pre[j * NB_GRU_GATE + GATE_R];
+				zz[j] = (DATA_T)pre[j * NB_GRU_GATE + GATE_Z];
+				h_new[j] = wx[j * NB_GRU_GATE + GATE_H];
+			}
+			activation_apply<INNER_AC_FN, OUTPUT_DIM>(rr);
+			activation_apply<INNER_AC_FN, OUTPUT_DIM>(zz);
+
+			for( int k = 0; k < OUTPUT_DIM; k++)
+			{
+				rh[k] = rr[k] * res[k];
+				const WEIGHT_T *u = weight[k + INPUT_DIM];
+				for( int j = 0; j < OUTPUT_DIM; j++)
+				{
+					h_new[j] += rh[k] * u[j * NB_GRU_GATE + GATE_H];
+				}
+			}
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				hh[j] = (DATA_T)h_new[j];
+			}
+			activation_apply<AC_FN, OUTPUT_DIM>(hh);
+
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				res[j] = (1 - zz[j]) * res[j] + zz[j] * hh[j];
+			}
+			if( AC_FN == SOFTMAX )
+			{
+				activation_softmax<OUTPUT_DIM>(res);
+			}
+#if CALIBRATION_HOST
+			calibration().data(calib, res, OUTPUT_DIM);
+#endif
+			return;
+		}
+#endif
+		for( int j = 0; j <OUTPUT_DIM; j++)
+		{
+#if RECURRENT_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+			/* the input data weight and bias */
+			ACC_T r = wx[j * NB_GRU_GATE + GATE_R];
+			ACC_T z = wx[j * NB_GRU_GATE + GATE_Z];
+
+			for( int k = 0; k < OUTPUT_DIM; k++)
+			{
+#if RECURRENT_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+				DATA_T prev_h = res[k];
+				r += prev_h * weight[k + INPUT_DIM][j * NB_GRU_GATE + GATE_R];
+				z += prev_h * weight[k + INPUT_DIM][j * NB_GRU_GATE + GATE_Z];
+			}
+
+			/* calculate the inner activation function */
+			rr[j] = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)r);
+			zz[j] = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)z);
+
+			/* calculate the r * h */
+			rh[j] = rr[j] * res[j];
+		}
+
+		/* calculate the new h*/
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+#if RECURRENT_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+			/* the W and bias */
+			ACC_T h_new = wx[j * NB_GRU_GATE + GATE_H];
+
+			for( int k = 0; k < OUTPUT_DIM; k++)
+			{
+#if RECURRENT_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+				h_new += rh[k] * weight[k + INPUT_DIM][j * NB_GRU_GATE + GATE_H];
+			}
+
+			/* calculate the activation function */
+			DATA_T hh_new;
+			hh_new = activation_fn<AC_FN, DATA_T>((DATA_T)h_new);
+
+			/* calculate and update the final result */
+			res[j] = (1 - zz[j]) * res[j] + zz[j] * hh_new;
+		}
+
+		/* for the activation of softmax */
+		if( AC_FN == SOFTMAX )
+		{
+			activation_softmax<OUTPUT_DIM>(res);
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, res, OUTPUT_DIM);
+#endif
+	}
+};
+
+/*
+ * @note: define the Long Short Term Memory(LSTM) Neural Network, http://deeplearning.net/tutorial/lstm.html
+ */
+template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN = TANH, ACTIVATION INNER_AC_FN = SIGMOID,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class LSTM
+{
+public:
+	LSTM(const TYPE_T *WEIGHT_I, const TYPE_T *WEIGHT_C, const TYPE_T *WEIGHT_F, const TYPE_T *WEIGHT_O)
+	{
+#pragma HLS ARRAY_RESHAPE variable=weight cyclic factor=4 dim=2
+
+#if DEBUG
+		cout<<"LSTM Layer......"<<endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tINPUT_LENGTH = " << INPUT_LENGTH << endl;
+#endif
+
+		/* initialize the weights, the gates of one unit are interleaved */
+		for( int i = 0; i < OUTPUT_DIM + INPUT_DIM + 1; i++)
+		{
+			for(int j = 0; j < OUTPUT_DIM; j++)
+			{
+				weight[i][j * NB_LSTM_GATE + GATE_I] = WEIGHT_I[i*OUTPUT_DIM + j];
+				weight[i][j * NB_LSTM_GATE + GATE_C] = WEIGHT_C[i*OUTPUT_DIM + j];
+				weight[i][j * NB_LSTM_GATE + GATE_F] = WEIGHT_F[i*OUTPUT_DIM + j];
+				weight[i][j * NB_LSTM_GATE + GATE_O] = WEIGHT_O[i*OUTPUT_DIM + j];
+			}
+		}
+#if CALIBRATION_HOST
+		calib = calibration().find("LSTM", WEIGHT_I);
+		calibration().weight(calib, &weight[0][0], (OUTPUT_DIM + INPUT_DIM + 1) * NB_LSTM_GATE * OUTPUT_DIM);
+#endif
+	}
+
+public:
+	/* the packed weight, weight[k][j * NB_LSTM_GATE + GATE_I/GATE_C/GATE_F/GATE_O] */
+	WEIGHT_T	weight[OUTPUT_DIM + INPUT_DIM + 1][NB_LSTM_GATE * OUTPUT_DIM];
+	DATA_T		res[OUTPUT_DIM];
+	/* the memory cell is kept in ACC_T, it is a running sum over the timesteps */
+	ACC_T		ct[OUTPUT_DIM];
+#if CALIBRATION_HOST
+	/* the index of the layer in calibration() */
+	int		calib;
+#endif
+
+public:
+	/*
+	 * @note: the feed forward function
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM])
+	{
+		feedforward(data, INPUT_LENGTH);
+	}
+
+	/*
+	 * @note: the feedforward function of a padded sequence, only the first length timesteps are calculated
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM], int length)
+	{
+#if RECURRENT_INPUT_PRECOMPUTE
+		/* calculate the W and b of all the timesteps before the recurrence */
+		ACC_T	wx[INPUT_LENGTH][NB_LSTM_GATE * OUTPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			if( i == length )
+				break;
+			input_projection(data[i], wx[i]);
+		}
+#endif
+
+		/* initialize the context */
+		reset_state();
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+#if RECURRENT_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+			if( i == length )
+				break;
+#if RECURRENT_INPUT_PRECOMPUTE
+			recurrence(wx[i]);
+#else
+			step(data[i]);
+#endif
+		}
+	}
+
+	/*
+	 * @note: advance the context by one timestep, h(t) is left in res and c(t) in ct
+	 */
+	template<typename IN_T>
+	void step(const IN_T x[INPUT_DIM])
+	{
+		ACC_T	wx[NB_LSTM_GATE * OUTPUT_DIM];
+		input_projection(x, wx);
+		recurrence(wx);
+	}
+
+	/*
+	 * @note: clear the context before a new sequence is fed with step()
+	 */
+	void reset_state()
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			res[i] = 0;
+			ct[i] = 0;
+		}
+	}
+
+	/*
+	 * @note: save and restore the context, one layer can serve several independent sequences in turn
+	 */
+	void save_state(DATA_T h[OUTPUT_DIM], ACC_T c[OUTPUT_DIM])
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			h[i] = res[i];
+			c[i] = ct[i];
+		}
+	}
+
+	void restore_state(const DATA_T h[OUTPUT_DIM], const ACC_T c[OUTPUT_DIM])
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			res[i] = h[i];
+			ct[i] = c[i];
+		}
+	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, one sequence of INPUT_LENGTH x INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_LENGTH][INPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				data[i][j] = in.read();
+			}
+		}
+
+		feedforward(data);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
+
+	/*
+	 * @note: the feedforward function returning the sequence, h(t) of every timestep is written to seq
+	 */
+	template<typename IN_T>
+	void feedforward_sequences(IN_T data[INPUT_LENGTH][INPUT_DIM], DATA_T seq[INPUT_LENGTH][OUTPUT_DIM])
+	{
+		reset_state();
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			step(data[i]);
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				seq[i][j] = res[j];
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedforward function returning the sequence with FIFO channels, INPUT_DIM is read and OUTPUT_DIM is written per timestep
+	 * 	so a following recurrent layer can start on h(t) while this layer works on x(t+1)
+	 */
+	template<typename IN_T>
+	void feedforward_sequences(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		reset_state();
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			DATA_T x[INPUT_DIM];
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				x[j] = in.read();
+			}
+
+			step(x);
+
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				out.write(res[j]);
+			}
+		}
+	}
+
+public:
+	/*
+	 * @note: calculate the W and b of one timestep, packed in the same gate order as weight, it is also used by LSTM_Batch
+	 */
+	template<typename IN_T>
+	void input_projection(const IN_T x[INPUT_DIM], ACC_T wx[NB_LSTM_GATE * OUTPUT_DIM])
+	{
+#pragma HLS inline
+#if HOST_NATIVE
+		host_gemv<DATA_T, ACC_T, NB_LSTM_GATE * OUTPUT_DIM, INPUT_DIM>(x, &weight[0][0], weight[OUTPUT_DIM + INPUT_DIM], wx);
+		return;
+#endif
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+#if RECURRENT_PERF_MODE == PERF_HIGH || RECURRENT_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+			ACC_T	it =  weight[OUTPUT_DIM + INPUT_DIM][j * NB_LSTM_GATE + GATE_I];
+			ACC_T	cc =  weight[OUTPUT_DIM + INPUT_DIM][j * NB_LSTM_GATE + GATE_C];
+			ACC_T 	ft =  weight[OUTPUT_DIM + INPUT_DIM][j * NB_LSTM_GATE + GATE_F];
+			ACC_T  ot =  weight[OUTPUT_DIM + INPUT_DIM][j * NB_LSTM_GATE + GATE_O];
+			for( int k = 0; k < INPUT_DIM; k++)
+			{
+#if RECURRENT_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+				DATA_T xk = x[k];
+				it += (weight[k][j * NB_LSTM_GATE + GATE_I] * xk);
+				cc += (weight[k][j * NB_LSTM_GATE + GATE_C] * xk);
+				ft += (weight[k][j * NB_LSTM_GATE + GATE_F] * xk);
+				ot += (weight[k][j * NB_LSTM_GATE + GATE_O] * xk);
+			}
+			wx[j * NB_LSTM_GATE + GATE_I] = it;
+			wx[j * NB_LSTM_GATE + GATE_C] = cc;
+			wx[j * NB_LSTM_GATE + GATE_F] = ft;
+			wx[j * NB_LSTM_GATE + GATE_O] = ot;
+		}
+	}
+
+private:
+	/*
+	 * @note: add the U to the input projection and update the context
+	 */
+	void recurrence(const ACC_T wx[NB_LSTM_GATE * OUTPUT_DIM])
+	{
+#pragma HLS inline
+#if HOST_NATIVE
+		{
+			/* h(t - 1) times the row major recurrent weight, the gates of all the units at once */
+			ACC_T	pre[NB_LSTM_GATE * OUTPUT_DIM];
+			DATA_T	gate[NB_LSTM_GATE][OUTPUT_DIM];
+			host_gemv<DATA_T, ACC_T, NB_LSTM_GATE * OUTPUT_DIM, OUTPUT_DIM>(res, &weight[INPUT_DIM][0], wx, pre);
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				for( int g = 0; g < NB_LSTM_GATE; g++)
+				{
+					gate[g][j] = (DATA_T)pre[j * NB_LSTM_GATE + g];
+				}
+			}
+			activation_apply<INNER_AC_FN, OUTPUT_DIM>(gate[GATE_I]);
+			activation_apply<INNER_AC_FN, OUTPUT_DIM>(gate[GATE_F]);
+			activation_apply<INNER_AC_FN, OUTPUT_DIM>(gate[GATE_O]);
+			activation_apply<AC_FN, OUTPUT_DIM>(gate[GATE_C]);
+
+			DATA_T	ct_o[OUTPUT_DIM];
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				ct[j] = gate[GATE_I][j] * gate[GATE_C][j] + gate[GATE_F][j] * ct[j];
+				ct_o[j] = (DATA_T)ct[j];
+			}
+			activation_apply<AC_FN, OUTPUT_DIM>(ct_o);
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				res[j] = gate[GATE_O][j] * ct_o[j];
+			}
+			if( AC_FN == SOFTMAX )
+			{
+				activation_softmax<OUTPUT_DIM>(res);
+			}
+#if CALIBRATION_HOST
+			calibration().data(calib, res, OUTPUT_DIM);
+#endif
+			return;
+		}
+#endif
+		/* keep h(t-1) while h(t) is calculated */
+		DATA_T	prev_h[OUTPUT_DIM];
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+			prev_h[j] = res[j];
+		}
+
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+#if RECURRENT_PERF_MODE == PERF_MEDIAN
+#pragma HLS pipeline
+#endif
+			/* the W and b*/
+			ACC_T	it =  wx[j * NB_LSTM_GATE + GATE_I];
+			ACC_T	cc =  wx[j * NB_LSTM_GATE + GATE_C];
+			ACC_T 	ft =  wx[j * NB_LSTM_GATE + GATE_F];
+			ACC_T  ot =  wx[j * NB_LSTM_GATE + GATE_O];
+
+			/* calculate the U */
+			for(int k = 0; k < OUTPUT_DIM; k++)
+			{
+#if RECURRENT_PERF_MODE == PERF_LOW
+#pragma HLS pipeline
+#endif
+				DATA_T	pre_h = prev_h[k];
+				it += pre_h * weight[k + INPUT_DIM][j * NB_LSTM_GATE + GATE_I];
+				cc += pre_h * weight[k + INPUT_DIM][j * NB_LSTM_GATE + GATE_C];
+				ft += pre_h * weight[k + INPUT_DIM][j * NB_LSTM_GATE + GATE_F];
+				ot += pre_h * weight[k + INPUT_DIM][j * NB_LSTM_GATE + GATE_O];
+			}
+
+
+			/* the inner activation function */
+			DATA_T it_o, ft_o, ot_o;
+			it_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)it);
+			ft_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)ft);
+			ot_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)ot);
+
+			/* the activation function */
+			DATA_T cc_o;
+			cc_o = activation_fn<AC_FN, DATA_T>((DATA_T)cc);
+
+			/* calculate the memory cell output */
+			ACC_T	ct_new = it_o * cc_o + ft_o * ct[j];
+
+			/* the activation function */
+			DATA_T ct_o;
+			ct_o = activation_fn<AC_FN, DATA_T>((DATA_T)ct_new);
+
+			/* calculate the result */
+			res[j] = ot_o * ct_o;
+			ct[j] = ct_new;
+
+		}
+
+		/* for the activation of softmax */
+		if( AC_FN == SOFTMAX )
+		{
+			activation_softmax<OUTPUT_DIM>(res);
+		}
+#if CALIBRATION_HOST
+		calibration().data(calib, res, OUTPUT_DIM);
+#endif
+	}
+};
+
+/*
+ * @note: the LSTM for a batch of independent sequences, the sequences are advanced in round-robin
+ * 	so each weight is read once for the whole batch and the accumulation of one sequence
+ * 	is not waited on by the next iteration of the pipeline
+ * 	the weight and the input projection are those of an LSTM layer, and the host backend runs that layer sequence by sequence
+ * 	the accumulation of a sequence is revisited every NB_SEQ iterations, so NB_SEQ should be at least
+ * 	the latency of the ACC_T adder, e.g. 4 or more for float, for the loop to be pipelined with II=1
+ * 	DATA_T is the type of the input and output, WEIGHT_T of the weight and bias, ACC_T of the sum of products and the memory cell
+ * 	the input_shape = {NB_SEQ, INPUT_LENGTH, INPUT_DIM}
+ * 	the output shape = {NB_SEQ, OUTPUT_DIM}
+ */
+template<int NB_SEQ, int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN = TANH, ACTIVATION INNER_AC_FN = SIGMOID,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class LSTM_Batch
+{
+public:
+	LSTM_Batch(const TYPE_T *WEIGHT_I, const TYPE_T *WEIGHT_C, const TYPE_T *WEIGHT_F, const TYPE_T *WEIGHT_O)
+		:lstm(WEIGHT_I, WEIGHT_C, WEIGHT_F, WEIGHT_O)
+	{
+		assert(NB_SEQ > 0);
+		assert(INPUT_LENGTH > 0);
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+
+#if DEBUG
+		cout<<"LSTM_Batch Layer......"<<endl;
+		cout<<"\tNB_SEQ = " << NB_SEQ << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tINPUT_LENGTH = " << INPUT_LENGTH << endl;
+#endif
+	}
+
+public:
+	/* the LSTM holding the packed weight, lstm.weight[k][j * NB_LSTM_GATE + GATE_I/GATE_C/GATE_F/GATE_O] */
+	LSTM<INPUT_LENGTH, INPUT_DIM, OUTPUT_DIM, AC_FN, INNER_AC_FN, DATA_T, WEIGHT_T, ACC_T>	lstm;
+	DATA_T	res[NB_SEQ][OUTPUT_DIM];
+	ACC_T	ct[NB_SEQ][OUTPUT_DIM];
+
+public:
+	/*
+	 * @note: the feed forward function
+	 * @params: the input data is a 3D array with NB_SEQ x INPUT_LENGTH x INPUT_DIM
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[NB_SEQ][INPUT_LENGTH][INPUT_DIM])
+	{
+#if HOST_NATIVE
+		for( int n = 0; n < NB_SEQ; n++)
+		{
+			lstm.feedforward(data[n]);
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				res[n][j] = lstm.res[j];
+				ct[n][j] = lstm.ct[j];
+			}
+		}
+		return;
+#endif
+
+#if RECURRENT_INPUT_PRECOMPUTE
+		/* calculate the W and b of all the sequences and timesteps before the recurrence */
+		ACC_T	wx[NB_SEQ][INPUT_LENGTH][NB_LSTM_GATE * OUTPUT_DIM];
+		for( int n = 0; n < NB_SEQ; n++)
+		{
+			for( int i = 0; i < INPUT_LENGTH; i++)
+			{
+				lstm.input_projection(data[n][i], wx[n][i]);
+			}
+		}
+		/* only U is left in the recurrence */
+		const int K_BEGIN = INPUT_DIM;
+#else
+		const int K_BEGIN = 0;
+#endif
+
+		/* initialize the context */
+		for( int n = 0; n < NB_SEQ; n++)
+		{
+			for( int i = 0; i < OUTPUT_DIM; i++)
+			{
+#pragma HLS pipeline
+				res[n][i] = 0;
+				ct[n][i] = 0;
+			}
+		}
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			/* keep h(t-1) of every sequence while h(t) is calculated */
+			DATA_T	prev_h[NB_SEQ][OUTPUT_DIM];
+			for( int n = 0; n < NB_SEQ; n++)
+			{
+				for( int j = 0; j < OUTPUT_DIM; j++)
+				{
+#pragma HLS pipeline
+					prev_h[n][j] = res[n][j];
+				}
+			}
+
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				/* the accumulator of each sequence and gate */
+				ACC_T	acc[NB_SEQ][NB_LSTM_GATE];
+#pragma HLS ARRAY_PARTITION variable=acc dim=2 complete
+
+				/* add the W and b, or only the bias */
+				for( int n = 0; n < NB_SEQ; n++)
+				{
+#pragma HLS pipeline
+					for( int g = 0; g < NB_LSTM_GATE; g++)
+					{
+#if RECURRENT_INPUT_PRECOMPUTE
+						acc[n][g] = wx[n][i][j * NB_LSTM_GATE + g];
+#else
+						acc[n][g] = lstm.weight[OUTPUT_DIM + INPUT_DIM][j * NB_LSTM_GATE + g];
+#endif
+					}
+				}
+
+				/* calculate the W and U, every weight is read once and used by the sequences in turn */
+				WEIGHT_T	w[NB_LSTM_GATE];
+#pragma HLS ARRAY_PARTITION variable=w dim=1 complete
+				for( int k = K_BEGIN; k < INPUT_DIM + OUTPUT_DIM; k++)
+				{
+					for( int n = 0; n < NB_SEQ; n++)
+					{
+#pragma HLS pipeline
+#pragma HLS DEPENDENCE variable=acc inter false
+						if( n == 0 )
+						{
+							for( int g = 0; g < NB_LSTM_GATE; g++)
+							{
+#pragma HLS unroll
+								w[g] = lstm.weight[k][j * NB_LSTM_GATE + g];
+							}
+						}
+
+						DATA_T xk = (k < INPUT_DIM) ? (DATA_T)data[n][i][k] : prev_h[n][k - INPUT_DIM];
+						for( int g = 0; g < NB_LSTM_GATE; g++)
+						{
+#pragma HLS unroll
+							acc[n][g] += w[g] * xk;
+						}
+					}
+				}
+
+				/* update the context of each sequence */
+				for( int n = 0; n < NB_SEQ; n++)
+				{
+#pragma HLS pipeline
+					/* the inner activation function */
+					DATA_T it_o, ft_o, ot_o;
+					it_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)acc[n][GATE_I]);
+					ft_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)acc[n][GATE_F]);
+					ot_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)acc[n][GATE_O]);
+
+					/* the activation function */
+					DATA_T cc_o;
+					cc_o = activation_fn<AC_FN, DATA_T>((DATA_T)acc[n][GATE_C]);
+
+					/* calculate the memory cell output */
+					ACC_T	ct_new = it_o * cc_o + ft_o * ct[n][j];
+
+					/* calculate the result */
+					res[n][j] = ot_o * activation_fn<AC_FN, DATA_T>((DATA_T)ct_new);
+					ct[n][j] = ct_new;
+				}
+			}
+
+			/* for the activation of softmax */
+			if( AC_FN == SOFTMAX )
+			{
+				for( int n = 0; n < NB_SEQ; n++)
+				{
+					activation_softmax<OUTPUT_DIM>(res[n]);
+				}
+			}
+		}
+	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, NB_SEQ sequences are read and written in order
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[NB_SEQ][INPUT_LENGTH][INPUT_DIM];
+		for( int n = 0; n < NB_SEQ; n++)
+		{
+			for( int i = 0; i < INPUT_LENGTH; i++)
+			{
+				for( int j = 0; j < INPUT_DIM; j++)
+				{
+#pragma HLS pipeline
+					data[n][i][j] = in.read();
+				}
+			}
+		}
+
+		feedforward(data);
+
+		for( int n = 0; n < NB_SEQ; n++)
+		{
+			for( int i = 0; i < OUTPUT_DIM; i++)
+			{
+#pragma HLS pipeline
+				out.write(res[n][i]);
+			}
+		}
+	}
+};
+
+/*
+ * @note: the LSTM with streamed weight, only the context and two tile buffers are kept on chip
+ * 	the weight is laid out tile by tile, tile (j * NB_LSTM_GATE + g) is gate g of unit j
+ * 	with the OUTPUT_DIM + INPUT_DIM + 1 values {W, U, b}, see pack_weight()
+ * 	DATA_T is the type of the input and output, WEIGHT_T of the streamed weight and bias, ACC_T of the sum of products and the memory cell
+ * 	the input_shape = {INPUT_LENGTH, INPUT_DIM}
+ * 	the output shape = {OUTPUT_DIM}
+ */
+template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, ACTIVATION AC_FN = TANH, ACTIVATION INNER_AC_FN = SIGMOID,
+		typename DATA_T = TYPE_T, typename WEIGHT_T = TYPE_T, typename ACC_T = TYPE_T>
+class LSTM_WeightStream
+{
+public:
+	LSTM_WeightStream()
+	{
+		assert(INPUT_LENGTH > 0);
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+#if DEBUG
+		cout<<"LSTM_WeightStream Layer......"<<endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tINPUT_LENGTH = " << INPUT_LENGTH << endl;
+#endif
+	}
+
+public:
+	DATA_T	res[OUTPUT_DIM];
+	/* the memory cell is kept in ACC_T as in LSTM */
+	ACC_T	ct[OUTPUT_DIM];
+
+public:
+	/*
+	 * @note: pack the four gate weights of LSTM into the tile layout read by feedforward, used on the host
+	 */
+	static void pack_weight(const TYPE_T *WEIGHT_I, const TYPE_T *WEIGHT_C, const TYPE_T *WEIGHT_F, const TYPE_T *WEIGHT_O, WEIGHT_T *weight)
+	{
+		const TYPE_T *gate[NB_LSTM_GATE];
+		gate[GATE_I] = WEIGHT_I;
+		gate[GATE_C] = WEIGHT_C;
+		gate[GATE_F] = WEIGHT_F;
+		gate[GATE_O] = WEIGHT_O;
+
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+			for( int g = 0; g < NB_LSTM_GATE; g++)
+			{
+				for( int k = 0; k < OUTPUT_DIM + INPUT_DIM + 1; k++)
+					weight[(j * NB_LSTM_GATE + g) * (OUTPUT_DIM + INPUT_DIM + 1) + k] = gate[g][k * OUTPUT_DIM + j];
+			}
+		}
+	}
+
+	/*
+	 * @note: the feed forward function
+	 * @params: the weight is packed by pack_weight(), the input data is a 2D array with INPUT_LENGTH x INPUT_DIM
+	 */
+	template<typename IN_T>
+	void feedforward(volatile WEIGHT_T *weight, IN_T data[INPUT_LENGTH][INPUT_DIM])
+	{
+		/* define two 1D line buffers used as ping-pong banks */
+		LineBuffer1D<OUTPUT_DIM + INPUT_DIM + 1, WEIGHT_T>	ping;
+		LineBuffer1D<OUTPUT_DIM + INPUT_DIM + 1, WEIGHT_T>	pong;
+
+		/* initialize the context */
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			res[i] = 0;
+			ct[i] = 0;
+		}
+
+		/* copy the first tile before the computation starts */
+		ping.fill(&weight[0]);
+
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			/* the input of this timestep followed by h(t-1) */
+			DATA_T	xh[INPUT_DIM + OUTPUT_DIM];
+			for( int k = 0; k < INPUT_DIM; k++)
+			{
+#pragma HLS pipeline
+				xh[k] = (DATA_T)data[i][k];
+			}
+			for( int k = 0; k < OUTPUT_DIM; k++)
+			{
+#pragma HLS pipeline
+				xh[k + INPUT_DIM] = res[k];
+			}
+
+			for( int j = 0; j < OUTPUT_DIM; j++)
+			{
+				ACC_T	acc[NB_LSTM_GATE];
+#pragma HLS ARRAY_PARTITION variable=acc dim=1 complete
+
+				for( int g = 0; g < NB_LSTM_GATE; g++)
+				{
+					/* compute one tile from one bank while the next tile, wrapping to the next timestep, is burst into the other */
+					int tile = j * NB_LSTM_GATE + g;
+					int next = (tile + 1) % (NB_LSTM_GATE * OUTPUT_DIM);
+					bool prefetch = (i + 1 < INPUT_LENGTH) || (tile + 1 < NB_LSTM_GATE * OUTPUT_DIM);
+					if( tile % 2 == 0 )
+						acc[g] = mac_prefetch(ping, pong, &weight[next * (OUTPUT_DIM + INPUT_DIM + 1)], prefetch, xh);
+					else
+						acc[g] = mac_prefetch(pong, ping, &weight[next * (OUTPUT_DIM + INPUT_DIM + 1)], prefetch, xh);
+				}
+
+				/* the inner activation function */
+				DATA_T it_o, ft_o, ot_o;
+				it_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)acc[GATE_I]);
+				ft_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)acc[GATE_F]);
+				ot_o = activation_fn<INNER_AC_FN, DATA_T>((DATA_T)acc[GATE_O]);
+
+				/* the activation function */
+				DATA_T cc_o;
+				cc_o = activation_fn<AC_FN, DATA_T>((DATA_T)acc[GATE_C]);
+
+				/* calculate the memory cell output */
+				ACC_T	ct_new = it_o * cc_o + ft_o * ct[j];
 
 				/* calculate the result */
-				res[j] = ot_o * ct_o;
+				res[j] = ot_o * activation_fn<AC_FN, DATA_T>((DATA_T)ct_new);
 				ct[j] = ct_new;
-
 			}
 
 			/* for the activation of softmax */
@@ -364,6 +1386,264 @@ public:
 			}
 		}
 	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, one sequence of INPUT_LENGTH x INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	template<typename IN_T>
+	void feedforward(volatile WEIGHT_T *weight, hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_LENGTH][INPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				data[i][j] = in.read();
+			}
+		}
+
+		feedforward(weight, data);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
+
+private:
+	/*
+	 * @note: multiply the tile in cur and, in the same pipelined loop, burst the next tile into next
+	 */
+	ACC_T mac_prefetch(LineBuffer1D<OUTPUT_DIM + INPUT_DIM + 1, WEIGHT_T> &cur, LineBuffer1D<OUTPUT_DIM + INPUT_DIM + 1, WEIGHT_T> &next,
+			volatile WEIGHT_T *weight, bool prefetch, DATA_T xh[INPUT_DIM + OUTPUT_DIM])
+	{
+#pragma HLS inline
+		/* the bias */
+		ACC_T tmp = cur.getval( OUTPUT_DIM + INPUT_DIM );
+
+		for( int k = 0; k < OUTPUT_DIM + INPUT_DIM + 1; k++)
+		{
+#pragma HLS pipeline
+			if( prefetch )
+				next.getval(k) = weight[k];
+			if( k < OUTPUT_DIM + INPUT_DIM )
+				tmp += xh[k] * cur.getval(k);
+		}
+		return tmp;
+	}
+};
+
+/*
+ * @note: two stacked recurrent layers with the whole sequence returned from the first one
+ * 	the layers are advanced as a wavefront, the second layer calculates timestep t - 1 while the first one calculates timestep t
+ * 	LAYER_1 and LAYER_2 are SimpleRNN, GRU or LSTM with the shapes
+ * 	{INPUT_LENGTH, INPUT_DIM} -> {INPUT_LENGTH, HIDDEN_DIM} and {INPUT_LENGTH, HIDDEN_DIM} -> {OUTPUT_DIM}
+ * 	DATA_T is the type of the hidden sequence and the output, the same as the DATA_T of the layers
+ * 	the input_shape = {INPUT_LENGTH, INPUT_DIM}
+ * 	the output shape = {OUTPUT_DIM}
+ */
+template<int INPUT_LENGTH, int INPUT_DIM, int HIDDEN_DIM, int OUTPUT_DIM, class LAYER_1, class LAYER_2, typename DATA_T = TYPE_T>
+class StackedRNN
+{
+public:
+	StackedRNN(LAYER_1 &L1, LAYER_2 &L2):layer1(L1), layer2(L2)
+	{
+		assert(INPUT_LENGTH > 0);
+		assert(INPUT_DIM > 0);
+		assert(HIDDEN_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+#if DEBUG
+		cout<<"StackedRNN Layer......"<<endl;
+		cout<<"\tINPUT_LENGTH = " << INPUT_LENGTH << endl;
+		cout<<"\tHIDDEN_DIM = " << HIDDEN_DIM << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+#endif
+	}
+
+public:
+	LAYER_1	&layer1;
+	LAYER_2	&layer2;
+	DATA_T	res[OUTPUT_DIM];
+
+public:
+	/*
+	 * @note: the feedforward function
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM])
+	{
+		/* h(t - 1) of the first layer, the input of the second layer */
+		DATA_T	hidden[HIDDEN_DIM];
+
+		layer1.reset_state();
+		layer2.reset_state();
+
+		for( int i = 0; i < INPUT_LENGTH + 1; i++)
+		{
+			/* the two steps do not depend on each other, so they are scheduled side by side */
+			if( i > 0 )
+				layer2.step(hidden);
+			if( i < INPUT_LENGTH )
+				layer1.step(data[i]);
+
+			for( int j = 0; j < HIDDEN_DIM; j++)
+			{
+#pragma HLS pipeline
+				hidden[j] = layer1.res[j];
+			}
+		}
+
+		for( int j = 0; j < OUTPUT_DIM; j++)
+		{
+#pragma HLS pipeline
+			res[j] = layer2.res[j];
+		}
+	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, one sequence of INPUT_LENGTH x INPUT_DIM is read and OUTPUT_DIM is written
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_LENGTH][INPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				data[i][j] = in.read();
+			}
+		}
+
+		feedforward(data);
+
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
+};
+
+/*
+ * @note: the bidirectional wrapper of SimpleRNN, GRU or LSTM, the forward and backward layers are built from separate weights
+ * 	and advance together, the timestep i of the forward layer with the timestep INPUT_LENGTH - 1 - i of the backward layer
+ * 	the input_shape = {INPUT_LENGTH, INPUT_DIM}
+ * 	the output shape = {OUT_DIM}, 2 * OUTPUT_DIM for MERGE_CONCAT and OUTPUT_DIM for MERGE_SUM
+ * 	DATA_T is the type of the merged output, the same as the DATA_T of RNN
+ */
+template<int INPUT_LENGTH, int INPUT_DIM, int OUTPUT_DIM, class RNN, MERGE_MODE MERGE = MERGE_CONCAT,
+	int OUT_DIM = (MERGE == MERGE_CONCAT ? 2 : 1) * OUTPUT_DIM, typename DATA_T = TYPE_T>
+class Bidirectional
+{
+public:
+	/* SimpleRNN */
+	Bidirectional(const TYPE_T *F_WEIGHT, const TYPE_T *B_WEIGHT)
+		:forward(F_WEIGHT), backward(B_WEIGHT)
+	{
+		info();
+	}
+
+	/* GRU */
+	Bidirectional(const TYPE_T *F_WEIGHT_Z, const TYPE_T *F_WEIGHT_R, const TYPE_T *F_WEIGHT_H,
+			const TYPE_T *B_WEIGHT_Z, const TYPE_T *B_WEIGHT_R, const TYPE_T *B_WEIGHT_H)
+		:forward(F_WEIGHT_Z, F_WEIGHT_R, F_WEIGHT_H), backward(B_WEIGHT_Z, B_WEIGHT_R, B_WEIGHT_H)
+	{
+		info();
+	}
+
+	/* LSTM */
+	Bidirectional(const TYPE_T *F_WEIGHT_I, const TYPE_T *F_WEIGHT_C, const TYPE_T *F_WEIGHT_F, const TYPE_T *F_WEIGHT_O,
+			const TYPE_T *B_WEIGHT_I, const TYPE_T *B_WEIGHT_C, const TYPE_T *B_WEIGHT_F, const TYPE_T *B_WEIGHT_O)
+		:forward(F_WEIGHT_I, F_WEIGHT_C, F_WEIGHT_F, F_WEIGHT_O), backward(B_WEIGHT_I, B_WEIGHT_C, B_WEIGHT_F, B_WEIGHT_O)
+	{
+		info();
+	}
+
+public:
+	RNN		forward;
+	RNN		backward;
+	DATA_T	res[OUT_DIM];
+
+public:
+	/*
+	 * @note: the feedforward function, the two layers have no data dependence and are scheduled in parallel in one loop
+	 */
+	template<typename IN_T>
+	void feedforward(IN_T data[INPUT_LENGTH][INPUT_DIM])
+	{
+		forward.reset_state();
+		backward.reset_state();
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+#if RECURRENT_PERF_MODE == PERF_HIGH
+#pragma HLS pipeline
+#endif
+			forward.step(data[i]);
+			backward.step(data[INPUT_LENGTH - 1 - i]);
+		}
+		merge();
+	}
+
+	/*
+	 * @note: the feedforward function with FIFO channels, one sequence of INPUT_LENGTH x INPUT_DIM is read and the merged output is written
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		DATA_T data[INPUT_LENGTH][INPUT_DIM];
+		for( int i = 0; i < INPUT_LENGTH; i++)
+		{
+			for( int j = 0; j < INPUT_DIM; j++)
+			{
+#pragma HLS pipeline
+				data[i][j] = in.read();
+			}
+		}
+
+		feedforward(data);
+
+		for( int i = 0; i < OUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write(res[i]);
+		}
+	}
+
+private:
+	void info()
+	{
+		assert(INPUT_LENGTH > 0);
+		assert(INPUT_DIM > 0);
+		assert(OUTPUT_DIM > 0);
+		assert(OUT_DIM == (MERGE == MERGE_CONCAT ? 2 : 1) * OUTPUT_DIM);
+#if DEBUG
+		cout<<"Bidirectional Layer......"<<endl;
+		cout<<"\tINPUT_LENGTH = " << INPUT_LENGTH << endl;
+		cout<<"\tOUTPUT_DIM = " << OUTPUT_DIM << endl;
+		cout<<"\tMERGE = " << (MERGE == MERGE_CONCAT ? "CONCAT" : "SUM") << endl;
+#endif
+	}
+
+	/*
+	 * @note: merge the final states, {forward, backward} for MERGE_CONCAT and forward + backward for MERGE_SUM
+	 */
+	void merge()
+	{
+		for( int i = 0; i < OUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			if( MERGE == MERGE_SUM )
+				res[i] = forward.res[i] + backward.res[i];
+			else if( i < OUTPUT_DIM )
+				res[i] = forward.res[i];
+			else
+				res[i] = backward.res[i - OUTPUT_DIM];
+		}
+	}
 };
 
 
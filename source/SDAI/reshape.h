@@ -5,6 +5,7 @@
 #ifndef __RESHAPE_H__
 #define __RESHAPE_H__
 #include "configure.h"
+#include "stream.h"
 #include "assert.h"
 
 #if DEBUG
@@ -20,7 +21,7 @@ typedef enum{ORDER_X}RESHAPE_MODE;
 /*
  * @note: convert 2D array to 1D array
  */
-template<int DIM1, int DIM2, RESHAPE_MODE MODE = ORDER_X, int OUTPUT_DIM = DIM1 * DIM2>
+template<int DIM1, int DIM2, RESHAPE_MODE MODE = ORDER_X, int OUTPUT_DIM = DIM1 * DIM2, typename DATA_T = TYPE_T>
 class Reshape2D_1D
 {
 public:
@@ -35,10 +36,11 @@ public:
 	};
 
 public:
-	TYPE_T res[OUTPUT_DIM];
+	DATA_T res[OUTPUT_DIM];
 
 public:
-	void feedforward(TYPE_T data[DIM1][DIM2])
+	template<typename IN_T>
+	void feedforward(IN_T data[DIM1][DIM2])
 	{
 		for( int i = 0; i < DIM1; i++)
 		{
@@ -58,12 +60,25 @@ public:
 			}
 		}
 	}
+
+	/*
+	 * @note: the FIFO channel is already in ORDER_X, so the data is only passed through
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write((DATA_T)in.read());
+		}
+	}
 };
 
 /*
  * @note: convert 3D array to 1D array
  */
-template<int DIM1, int DIM2, int DIM3, RESHAPE_MODE MODE = ORDER_X, int OUTPUT_DIM = DIM1 * DIM2 * DIM3>
+template<int DIM1, int DIM2, int DIM3, RESHAPE_MODE MODE = ORDER_X, int OUTPUT_DIM = DIM1 * DIM2 * DIM3, typename DATA_T = TYPE_T>
 class Reshape3D_1D
 {
 public:
@@ -79,10 +94,11 @@ public:
 	};
 
 public:
-	TYPE_T res[OUTPUT_DIM];
+	DATA_T res[OUTPUT_DIM];
 
 public:
-	void feedforward(TYPE_T data[DIM1][DIM2][DIM3])
+	template<typename IN_T>
+	void feedforward(IN_T data[DIM1][DIM2][DIM3])
 	{
 		for( int i = 0; i < DIM1; i++)
 		{
@@ -108,12 +124,25 @@ public:
 			}
 		}
 	}
+
+	/*
+	 * @note: the FIFO channel is already in ORDER_X, so the data is only passed through
+	 */
+	template<typename IN_T>
+	void feedforward(hls::stream<IN_T> &in, hls::stream<DATA_T> &out)
+	{
+		for( int i = 0; i < OUTPUT_DIM; i++)
+		{
+#pragma HLS pipeline
+			out.write((DATA_T)in.read());
+		}
+	}
 };
 
 /*
  * @note: convert stream to 1D array
  */
-template<int DIM1>
+template<int DIM1, typename DATA_T = TYPE_T>
 class Reshape_Stream_1D
 {
 public:
@@ -126,15 +155,16 @@ public:
 	};
 
 public:
-	TYPE_T res[DIM1];
+	DATA_T res[DIM1];
 
 public:
-	void feedforward(volatile TYPE_T *data)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data)
 	{
 		for( int i = 0; i < DIM1; i++)
 		{
 #pragma HLS pipeline
-			res[i] = data[i];
+			res[i] = (IN_T)data[i];
 		}
 
 	}
@@ -144,7 +174,7 @@ public:
 /*
  * @note: convert stream to 2D array
  */
-template<int DIM1, int DIM2, RESHAPE_MODE MODE = ORDER_X>
+template<int DIM1, int DIM2, RESHAPE_MODE MODE = ORDER_X, typename DATA_T = TYPE_T>
 class Reshape_Stream_2D
 {
 public:
@@ -158,10 +188,11 @@ public:
 	};
 
 public:
-	TYPE_T res[DIM1][DIM2];
+	DATA_T res[DIM1][DIM2];
 
 public:
-	void feedforward(volatile TYPE_T *data)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data)
 	{
 		for( int i = 0; i < DIM1; i++)
 		{
@@ -170,7 +201,7 @@ public:
 			{
 					switch(MODE)
 					{
-					case ORDER_X: res[i][j] = data[i * DIM2  + j]; break;
+					case ORDER_X: res[i][j] = (IN_T)data[i * DIM2  + j]; break;
 					default: assert(0); break;
 					}
 			}
@@ -181,7 +212,7 @@ public:
 /*
  * @note: convert stream to 3D array
  */
-template<int DIM1, int DIM2, int DIM3, RESHAPE_MODE MODE = ORDER_X>
+template<int DIM1, int DIM2, int DIM3, RESHAPE_MODE MODE = ORDER_X, typename DATA_T = TYPE_T>
 class Reshape_Stream_3D
 {
 public:
@@ -196,10 +227,11 @@ public:
 	};
 
 public:
-	TYPE_T res[DIM1][DIM2][DIM3];
+	DATA_T res[DIM1][DIM2][DIM3];
 
 public:
-	void feedforward(volatile TYPE_T *data)
+	template<typename IN_T>
+	void feedforward(volatile IN_T *data)
 	{
 		for( int i = 0; i < DIM1; i++)
 		{
@@ -210,7 +242,7 @@ public:
 #pragma HLS pipeline
 					switch(MODE)
 					{
-					case ORDER_X: res[i][j][k] = data[i * DIM2 * DIM3 + j * DIM3 + k]; break;
+					case ORDER_X: res[i][j][k] = (IN_T)data[i * DIM2 * DIM3 + j * DIM3 + k]; break;
 					default: assert(0); break;
 					}
 				}
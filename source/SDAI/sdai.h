@@ -6,6 +6,8 @@
 #define __SDAI_H__
 
 #include "../SDAI/activation.h"
+#include "../SDAI/binary.h"
+#include "../SDAI/calibration.h"
 #include "../SDAI/configure.h"
 #include "../SDAI/convolution1D.h"
 #include "../SDAI/convolution2D.h"
@@ -14,8 +16,11 @@
 #include "../SDAI/mem.h"
 #include "../SDAI/pooling1D.h"
 #include "../SDAI/pooling2D.h"
+#include "../SDAI/pow2.h"
+#include "../SDAI/quantize.h"
 #include "../SDAI/recurrent.h"
 #include "../SDAI/reshape.h"
+#include "../SDAI/stream.h"
 #include "../SDAI/utils.h"
 
 
@@ -0,0 +1,108 @@
+/*
+ * @date: 2026/10/17
+ */
+#ifndef __STREAM_H__
+#define __STREAM_H__
+#include "configure.h"
+
+#if HLS_STREAM || defined(__SYNTHESIS__)
+#include <hls_stream.h>
+#else
+#include <assert.h>
+#include <deque>
+
+/*
+ * @note: a plain C++ FIFO with the interface of hls::stream, it is only used for C simulation
+ * 	when the Xilinx hls_stream.h is not available, the FIFO has no depth limit
+ */
+namespace hls
+{
+
+template<typename __STREAM_T__>
+class stream
+{
+public:
+	stream()
+	{
+	}
+	stream(const char *name)
+	{
+	}
+
+private:
+	/* a stream can not be copied, it must be passed by reference */
+	stream(const stream &chn);
+	stream& operator= (const stream &chn);
+
+private:
+	std::deque<__STREAM_T__> fifo;
+
+public:
+	/*
+	 * @note: the state of the FIFO
+	 */
+	bool empty() const
+	{
+		return fifo.empty();
+	}
+	bool full() const
+	{
+		return false;
+	}
+	unsigned size() const
+	{
+		return fifo.size();
+	}
+
+	/*
+	 * @note: the blocking read
+	 */
+	__STREAM_T__ read()
+	{
+		assert(!fifo.empty());
+		__STREAM_T__ val = fifo.front();
+		fifo.pop_front();
+		return val;
+	}
+	void read(__STREAM_T__ &val)
+	{
+		val = read();
+	}
+	void operator >> (__STREAM_T__ &val)
+	{
+		val = read();
+	}
+
+	/*
+	 * @note: the non-blocking read
+	 */
+	bool read_nb(__STREAM_T__ &val)
+	{
+		if( fifo.empty() )
+			return false;
+		val = read();
+		return true;
+	}
+
+	/*
+	 * @note: the write
+	 */
+	void write(const __STREAM_T__ &val)
+	{
+		fifo.push_back(val);
+	}
+	void operator << (const __STREAM_T__ &val)
+	{
+		write(val);
+	}
+	bool write_nb(const __STREAM_T__ &val)
+	{
+		write(val);
+		return true;
+	}
+};
+
+}
+#endif
+
+#endif
@@ -10,21 +10,21 @@
 namespace SDAI
 {
 	/*
-	 * @note: find the catagory, that is the index of the maximum element
+	 * @note: find the catagory, that is the index of the maximum element, T is the type of the output layer
 	 */
-template<int INPUT_DIM>
-TYPE_PINT utils_find_category(TYPE_T data[INPUT_DIM])
+template<int INPUT_DIM, typename T>
+TYPE_PINT utils_find_category(T data[INPUT_DIM])
 {
 	assert(INPUT_DIM > 0);
 	/* set the initial as the first element */
-	TYPE_T	max = data[0];
+	T	max = data[0];
 	TYPE_PINT index = 0;
 
 	/* find the maximum element */
 	for( int i = 1; i < INPUT_DIM; i++)
 	{
 #pragma HLS pipeline
-		TYPE_T v = data[i];
+		T v = data[i];
 		if( v > max)
 		{
 			max = v;